@@ -0,0 +1,122 @@
+// Shared harness for the benchmarks: one producer thread publishing into a RingBuffer consumed by one
+// EventProcessor, timed end to end.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+
+#include "disruptor/event_handler.h"
+#include "disruptor/event_processor.h"
+#include "disruptor/exception_handler.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/sequencer.h"
+#include "disruptor/slot_layout.h"
+#include "disruptor/wait_strategies.h"
+
+namespace bench
+{
+
+    /**
+     * @brief Event of a given size in bytes; word 0 carries the sequence.
+     */
+    template <size_t Bytes>
+    struct BenchEvent
+    {
+        static_assert(Bytes >= 8 && Bytes % 8 == 0, "BenchEvent size must be a multiple of 8 bytes");
+
+        std::array<int64_t, Bytes / 8> words;
+    };
+
+    /**
+     * @brief Reads every word of every event, so the consumer pays for each line the producer wrote.
+     */
+    template <typename T>
+    class ReadingHandler : public disruptor::EventHandler<T>
+    {
+    public:
+        void onEvent(T &event, int64_t, bool) override
+        {
+            for (const int64_t word : event.words)
+            {
+                sum_ += word;
+            }
+        }
+
+        int64_t getSum() const
+        {
+            return sum_;
+        }
+
+    private:
+        int64_t sum_ = 0;
+    };
+
+    /**
+     * @brief Gets the event count from the first command-line argument, or a default.
+     */
+    inline int64_t eventCount(int argc, char **argv, int64_t fallback)
+    {
+        return argc > 1 ? std::atoll(argv[1]) : fallback;
+    }
+
+    /**
+     * @brief Publishes events through a ring and returns the throughput in millions of events per second.
+     *
+     * @tparam T The event type, a BenchEvent.
+     * @tparam Layout The slot layout policy.
+     * @tparam N The ring size.
+     * @param events Number of events to publish.
+     * @param prefetchDistance The consumer's prefetch distance.
+     */
+    template <typename T, typename Layout = disruptor::PackedLayout, size_t N = 1024>
+    double throughput(int64_t events, int64_t prefetchDistance = 0)
+    {
+        using namespace disruptor;
+
+        auto factory = []() -> T
+        {
+            return T{};
+        };
+        BusySpinWaitStrategy waitStrategy;
+        SingleProducerSequencer<N, BusySpinWaitStrategy> sequencer(waitStrategy);
+        RingBuffer<T, N, decltype(sequencer), decltype(factory), Layout> ringBuffer(sequencer, factory);
+        auto barrier = sequencer.newBarrier({});
+        ReadingHandler<T> handler;
+        DefaultExceptionHandler<T> exceptionHandler;
+        EventProcessor<T, decltype(ringBuffer), decltype(barrier), ReadingHandler<T>>
+            processor(ringBuffer, barrier, handler, exceptionHandler, 64, prefetchDistance);
+        ringBuffer.setGatingSequences({&processor.getSequence()});
+
+        std::thread consumer([&]
+                             { processor.run(); });
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int64_t i = 0; i < events; ++i)
+        {
+            const int64_t sequence = ringBuffer.next();
+            T &event = ringBuffer.get(sequence);
+            for (int64_t &word : event.words)
+            {
+                word = sequence;
+            }
+            ringBuffer.publish(sequence);
+        }
+        while (processor.getSequence().get() < events - 1)
+        {
+            cpu_relax();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        processor.halt();
+        consumer.join();
+
+        const double seconds = std::chrono::duration<double>(elapsed).count();
+        return static_cast<double>(events) / seconds / 1e6;
+    }
+
+} // namespace bench
@@ -0,0 +1,29 @@
+// Measures the consumer's prefetchDistance on 64 B, 256 B and 1 KB events.
+// Usage: prefetch_bench [events]
+
+#include <cstdio>
+
+#include "bench.h"
+
+template <size_t Bytes>
+void comparePrefetch(int64_t events)
+{
+    using Event = bench::BenchEvent<Bytes>;
+    std::printf("%6zu B", Bytes);
+    for (const int64_t distance : {0, 1, 2, 4, 8})
+    {
+        std::printf("  d=%lld %8.2f", static_cast<long long>(distance), bench::throughput<Event>(events, distance));
+    }
+    std::printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+    const int64_t events = bench::eventCount(argc, argv, 10'000'000);
+    std::printf("Mevents/s over %lld events by prefetch distance, one producer and one consumer\n",
+                static_cast<long long>(events));
+    comparePrefetch<64>(events);
+    comparePrefetch<256>(events);
+    comparePrefetch<1024>(events);
+    return 0;
+}
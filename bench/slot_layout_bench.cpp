@@ -0,0 +1,31 @@
+// Compares the slot layouts on small events, where packed slots share cache lines between the
+// producer and the consumer. Usage: slot_layout_bench [events]
+
+#include <cstdio>
+
+#include "bench.h"
+
+using namespace disruptor;
+
+template <size_t Bytes>
+void compareLayouts(int64_t events)
+{
+    using Event = bench::BenchEvent<Bytes>;
+    std::printf("%6zu B  packed %8.2f  padded %8.2f  padded(2) %8.2f  permuted %8.2f\n", Bytes,
+                bench::throughput<Event, PackedLayout>(events),
+                bench::throughput<Event, PaddedLayout<1>>(events),
+                bench::throughput<Event, PaddedLayout<2>>(events),
+                bench::throughput<Event, PermutedLayout>(events));
+}
+
+int main(int argc, char **argv)
+{
+    const int64_t events = bench::eventCount(argc, argv, 10'000'000);
+    std::printf("Mevents/s over %lld events, one producer and one consumer\n", static_cast<long long>(events));
+    compareLayouts<8>(events);
+    compareLayouts<16>(events);
+    compareLayouts<24>(events);
+    compareLayouts<32>(events);
+    compareLayouts<64>(events);
+    return 0;
+}
@@ -0,0 +1,591 @@
+/**
+ * @file async_write_handler.h
+ * @brief Defines the AsyncWriteHandler, writing events to a file through io_uring or a background writer thread.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <climits>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#define DISRUPTOR_HAS_IO_URING 1
+#endif
+
+#include "event_bytes.h"
+#include "event_handler.h"
+#include "sequence.h"
+#include "wait_strategies.h"
+
+namespace disruptor
+{
+
+    /**
+     * @brief One vectored write submitted to an AsyncWriter.
+     */
+    struct AsyncWriteRequest
+    {
+        int fd;
+        const iovec *iov;
+        unsigned count;
+        uint64_t offset;
+    };
+
+    /**
+     * @brief Backend executing AsyncWriteRequests off the calling thread.
+     *
+     * submit() is called from one thread; the completion callback runs on a single backend thread
+     * with the request index and the number of bytes written or -errno.
+     */
+    class AsyncWriter
+    {
+    public:
+        using Completion = std::function<void(size_t index, int64_t result)>;
+
+        virtual ~AsyncWriter() = default;
+
+        /**
+         * @brief Queues a write.
+         *
+         * @param request The write, whose iovecs must stay valid until completion.
+         * @param index Identifies the request in the completion callback.
+         */
+        virtual void submit(const AsyncWriteRequest &request, size_t index) = 0;
+    };
+
+    /**
+     * @brief AsyncWriter running pwritev() on a background thread.
+     *
+     * Used where io_uring is not available, e.g. older kernels or restricted sandboxes.
+     */
+    class ThreadAsyncWriter : public AsyncWriter
+    {
+    public:
+        /**
+         * @brief Starts the writer thread.
+         *
+         * @param completion Callback invoked after each write.
+         */
+        explicit ThreadAsyncWriter(Completion completion)
+            : completion_(std::move(completion)),
+              worker_([this]
+                      { writeLoop(); }) {}
+
+        ~ThreadAsyncWriter() override
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            condition_.notify_one();
+            worker_.join();
+        }
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        ThreadAsyncWriter(const ThreadAsyncWriter &) = delete;
+        ThreadAsyncWriter &operator=(const ThreadAsyncWriter &) = delete;
+        ThreadAsyncWriter(ThreadAsyncWriter &&) = delete;
+        ThreadAsyncWriter &operator=(ThreadAsyncWriter &&) = delete;
+
+        void submit(const AsyncWriteRequest &request, size_t index) override
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                queue_.emplace_back(request, index);
+            }
+            condition_.notify_one();
+        }
+
+    private:
+        Completion completion_;
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        std::deque<std::pair<AsyncWriteRequest, size_t>> queue_;
+        bool stopping_ = false;
+        std::thread worker_;
+
+        void writeLoop()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (true)
+            {
+                condition_.wait(lock, [this]
+                                { return !queue_.empty() || stopping_; });
+                if (queue_.empty())
+                {
+                    return;
+                }
+                const auto [request, index] = queue_.front();
+                queue_.pop_front();
+                lock.unlock();
+
+                const ssize_t written = ::pwritev(request.fd, request.iov, static_cast<int>(request.count),
+                                                  static_cast<off_t>(request.offset));
+                completion_(index, written < 0 ? -errno : written);
+
+                lock.lock();
+            }
+        }
+    };
+
+#ifdef DISRUPTOR_HAS_IO_URING
+
+    /**
+     * @brief AsyncWriter submitting IORING_OP_WRITEV through raw io_uring system calls.
+     *
+     * The calling thread only fills SQEs and calls io_uring_enter() to submit; a reaper thread
+     * blocks in io_uring_enter() for completions, so the submitter never waits on the disk.
+     */
+    class IoUringAsyncWriter : public AsyncWriter
+    {
+    public:
+        /**
+         * @brief Sets up the ring and starts the reaper thread.
+         *
+         * @param entries Submission queue size, at least the number of writes in flight.
+         * @param completion Callback invoked after each write.
+         * @throws std::system_error if io_uring is unavailable.
+         */
+        IoUringAsyncWriter(unsigned entries, Completion completion)
+            : completion_(std::move(completion))
+        {
+            io_uring_params params{};
+            ringFd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+            if (ringFd_ < 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "io_uring_setup");
+            }
+
+            sqSize_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+            cqSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            const bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (single)
+            {
+                sqSize_ = cqSize_ = std::max(sqSize_, cqSize_);
+            }
+            sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+
+            sq_ = map(sqSize_, IORING_OFF_SQ_RING);
+            cq_ = single ? sq_ : map(cqSize_, IORING_OFF_CQ_RING);
+            sqes_ = static_cast<io_uring_sqe *>(map(sqesSize_, IORING_OFF_SQES));
+
+            auto *sq = static_cast<char *>(sq_);
+            auto *cq = static_cast<char *>(cq_);
+            sqHead_ = reinterpret_cast<uint32_t *>(sq + params.sq_off.head);
+            sqTail_ = reinterpret_cast<uint32_t *>(sq + params.sq_off.tail);
+            sqMask_ = *reinterpret_cast<uint32_t *>(sq + params.sq_off.ring_mask);
+            sqEntries_ = params.sq_entries;
+            sqArray_ = reinterpret_cast<uint32_t *>(sq + params.sq_off.array);
+            cqHead_ = reinterpret_cast<uint32_t *>(cq + params.cq_off.head);
+            cqTail_ = reinterpret_cast<uint32_t *>(cq + params.cq_off.tail);
+            cqMask_ = *reinterpret_cast<uint32_t *>(cq + params.cq_off.ring_mask);
+            cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+            reaper_ = std::thread([this]
+                                  { reapLoop(); });
+        }
+
+        ~IoUringAsyncWriter() override
+        {
+            io_uring_sqe *sqe = claim();
+            sqe->opcode = IORING_OP_NOP;
+            sqe->user_data = kWakeup;
+            push();
+            reaper_.join();
+
+            ::munmap(sqes_, sqesSize_);
+            if (cq_ != sq_)
+            {
+                ::munmap(cq_, cqSize_);
+            }
+            ::munmap(sq_, sqSize_);
+            ::close(ringFd_);
+        }
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        IoUringAsyncWriter(const IoUringAsyncWriter &) = delete;
+        IoUringAsyncWriter &operator=(const IoUringAsyncWriter &) = delete;
+        IoUringAsyncWriter(IoUringAsyncWriter &&) = delete;
+        IoUringAsyncWriter &operator=(IoUringAsyncWriter &&) = delete;
+
+        void submit(const AsyncWriteRequest &request, size_t index) override
+        {
+            io_uring_sqe *sqe = claim();
+            sqe->opcode = IORING_OP_WRITEV;
+            sqe->fd = request.fd;
+            sqe->addr = reinterpret_cast<uint64_t>(request.iov);
+            sqe->len = request.count;
+            sqe->off = request.offset;
+            sqe->user_data = index;
+            push();
+        }
+
+    private:
+        static constexpr uint64_t kWakeup = ~uint64_t{0};
+
+        Completion completion_;
+        int ringFd_ = -1;
+        void *sq_ = nullptr;
+        void *cq_ = nullptr;
+        io_uring_sqe *sqes_ = nullptr;
+        size_t sqSize_ = 0;
+        size_t cqSize_ = 0;
+        size_t sqesSize_ = 0;
+        uint32_t *sqHead_ = nullptr;
+        uint32_t *sqTail_ = nullptr;
+        uint32_t sqMask_ = 0;
+        uint32_t sqEntries_ = 0;
+        uint32_t *sqArray_ = nullptr;
+        uint32_t *cqHead_ = nullptr;
+        uint32_t *cqTail_ = nullptr;
+        uint32_t cqMask_ = 0;
+        io_uring_cqe *cqes_ = nullptr;
+        std::thread reaper_;
+
+        void *map(size_t size, off_t offset)
+        {
+            void *mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, offset);
+            if (mapping == MAP_FAILED)
+            {
+                const int error = errno;
+                ::close(ringFd_);
+                throw std::system_error(error, std::generic_category(), "mmap io_uring");
+            }
+            return mapping;
+        }
+
+        io_uring_sqe *claim()
+        {
+            const uint32_t tail = std::atomic_ref<uint32_t>(*sqTail_).load(std::memory_order_relaxed);
+            while (tail - std::atomic_ref<uint32_t>(*sqHead_).load(std::memory_order_acquire) == sqEntries_)
+            {
+                cpu_relax();
+            }
+            io_uring_sqe *sqe = &sqes_[tail & sqMask_];
+            std::memset(sqe, 0, sizeof(*sqe));
+            return sqe;
+        }
+
+        void push()
+        {
+            const uint32_t tail = std::atomic_ref<uint32_t>(*sqTail_).load(std::memory_order_relaxed);
+            sqArray_[tail & sqMask_] = tail & sqMask_;
+            std::atomic_ref<uint32_t>(*sqTail_).store(tail + 1, std::memory_order_release);
+            while (::syscall(__NR_io_uring_enter, ringFd_, 1, 0, 0, nullptr, 0) < 0)
+            {
+                if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+                {
+                    throw std::system_error(errno, std::generic_category(), "io_uring_enter");
+                }
+            }
+        }
+
+        void reapLoop()
+        {
+            while (true)
+            {
+                uint32_t head = std::atomic_ref<uint32_t>(*cqHead_).load(std::memory_order_relaxed);
+                const uint32_t tail = std::atomic_ref<uint32_t>(*cqTail_).load(std::memory_order_acquire);
+                if (head == tail)
+                {
+                    ::syscall(__NR_io_uring_enter, ringFd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                    continue;
+                }
+                for (; head != tail; ++head)
+                {
+                    const io_uring_cqe &cqe = cqes_[head & cqMask_];
+                    if (cqe.user_data == kWakeup)
+                    {
+                        std::atomic_ref<uint32_t>(*cqHead_).store(head + 1, std::memory_order_release);
+                        return;
+                    }
+                    completion_(static_cast<size_t>(cqe.user_data), cqe.res);
+                }
+                std::atomic_ref<uint32_t>(*cqHead_).store(head, std::memory_order_release);
+            }
+        }
+    };
+
+#endif
+
+    /**
+     * @brief Event handler appending event payloads to a file without blocking on the disk.
+     *
+     * Payloads are gathered as iovecs pointing into the ring slots (no copy) and submitted as one
+     * vectored write per batch (at endOfBatch, or when MaxIov payloads are gathered), through
+     * io_uring when the kernel allows it and a writer thread otherwise. The processor's own
+     * sequence advances as soon as writes are submitted; getCompletedSequence() only advances once
+     * every write up to a sequence has completed, in order. Because the iovecs reference slot
+     * memory, register getCompletedSequence() as the ring's gating sequence in place of the
+     * processor's sequence, and gate stages that need the data on disk behind it.
+     *
+     * @tparam T The type of event.
+     * @tparam Payload Callable returning the bytes to write for an event, which must live in the slot
+     *                 (default: EventBytes<T>).
+     * @tparam MaxInFlight Maximum batches submitted and not yet completed (default: 64).
+     * @tparam MaxIov Maximum payloads per write (default: 64).
+     */
+    template <typename T, typename Payload = EventBytes<T>, size_t MaxInFlight = 64, size_t MaxIov = 64>
+    class AsyncWriteHandler : public EventHandler<T>
+    {
+        static_assert(MaxIov > 0 && MaxIov <= IOV_MAX, "MaxIov must be in [1, IOV_MAX]");
+
+    public:
+        /**
+         * @brief Constructs an AsyncWriteHandler.
+         *
+         * @param fd The file to write to; not owned.
+         * @param offset File offset of the first write (default: 0).
+         * @param payload Callable returning the bytes of an event.
+         * @param useIoUring Try io_uring before falling back to a writer thread (default: true).
+         */
+        explicit AsyncWriteHandler(int fd, uint64_t offset = 0, Payload payload = Payload{}, bool useIoUring = true)
+            : fd_(fd),
+              offset_(offset),
+              payload_(std::move(payload))
+        {
+            auto completion = [this](size_t index, int64_t result)
+            { complete(index, result); };
+#ifdef DISRUPTOR_HAS_IO_URING
+            if (useIoUring)
+            {
+                try
+                {
+                    writer_ = std::make_unique<IoUringAsyncWriter>(static_cast<unsigned>(MaxInFlight + 1), completion);
+                }
+                catch (const std::system_error &)
+                {
+                    // e.g. ENOSYS or EPERM under seccomp: use the writer thread
+                }
+            }
+#endif
+            if (!writer_)
+            {
+                writer_ = std::make_unique<ThreadAsyncWriter>(completion);
+            }
+        }
+
+        ~AsyncWriteHandler() override
+        {
+            writer_.reset();
+        }
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        AsyncWriteHandler(const AsyncWriteHandler &) = delete;
+        AsyncWriteHandler &operator=(const AsyncWriteHandler &) = delete;
+        AsyncWriteHandler(AsyncWriteHandler &&) = delete;
+        AsyncWriteHandler &operator=(AsyncWriteHandler &&) = delete;
+
+        void onEvent(T &event, int64_t sequence, bool endOfBatch) override
+        {
+            Batch &batch = batches_[submitted_ % MaxInFlight];
+            const std::span<const std::byte> bytes = payload_(event);
+            batch.iov[batch.count++] = {const_cast<std::byte *>(bytes.data()), bytes.size()};
+            batch.bytes += bytes.size();
+            batch.lastSequence = sequence;
+
+            if (batch.count == MaxIov || endOfBatch)
+            {
+                submit();
+            }
+        }
+
+        void onShutdown() override
+        {
+            // drain, so the file is complete once the processor has stopped
+            while (completed_.load(std::memory_order_acquire) != submitted_)
+            {
+                checkError();
+                std::this_thread::yield();
+            }
+            checkError();
+        }
+
+        /**
+         * @brief Gets the sequence up to which every write has completed.
+         *
+         * @return Reference to the completion sequence.
+         */
+        Sequence &getCompletedSequence()
+        {
+            return completedSequence_;
+        }
+
+        /**
+         * @brief Checks whether writes go through io_uring.
+         */
+        bool usesIoUring() const
+        {
+#ifdef DISRUPTOR_HAS_IO_URING
+            return dynamic_cast<IoUringAsyncWriter *>(writer_.get()) != nullptr;
+#else
+            return false;
+#endif
+        }
+
+    private:
+        struct Batch
+        {
+            std::array<iovec, MaxIov> iov;
+            unsigned count = 0;
+            size_t bytes = 0;
+            uint64_t offset = 0;
+            int64_t lastSequence = -1;
+            std::atomic<bool> done{false};
+        };
+
+        int fd_;
+        uint64_t offset_;
+        Payload payload_;
+        std::array<Batch, MaxInFlight> batches_;
+        size_t submitted_ = 0;
+
+        // written by the completion thread only
+        size_t head_ = 0;
+        std::atomic<size_t> completed_{0};
+        Sequence completedSequence_;
+        std::exception_ptr error_;
+        std::atomic<bool> failed_{false};
+
+        std::unique_ptr<AsyncWriter> writer_;
+
+        void submit()
+        {
+            checkError();
+            Batch &batch = batches_[submitted_ % MaxInFlight];
+            batch.offset = offset_;
+            offset_ += batch.bytes;
+            writer_->submit({fd_, batch.iov.data(), batch.count, batch.offset}, submitted_ % MaxInFlight);
+            ++submitted_;
+
+            // the next batch slot must have completed before it is refilled
+            while (submitted_ - completed_.load(std::memory_order_acquire) == MaxInFlight)
+            {
+                checkError();
+                cpu_relax();
+            }
+        }
+
+        void checkError()
+        {
+            if (failed_.load(std::memory_order_acquire))
+            {
+                std::rethrow_exception(error_);
+            }
+        }
+
+        void complete(size_t index, int64_t result)
+        {
+            Batch &batch = batches_[index];
+            if (result >= 0 && static_cast<size_t>(result) < batch.bytes)
+            {
+                result = finishShortWrite(batch, static_cast<size_t>(result));
+            }
+            if (result < 0)
+            {
+                error_ = std::make_exception_ptr(
+                    std::system_error(static_cast<int>(-result), std::generic_category(), "async write"));
+                failed_.store(true, std::memory_order_release);
+                return;
+            }
+            batch.done.store(true, std::memory_order_relaxed);
+
+            // completions may arrive out of order; only publish the contiguous prefix
+            int64_t lastSequence = -1;
+            while (batches_[head_ % MaxInFlight].done.load(std::memory_order_relaxed))
+            {
+                Batch &next = batches_[head_ % MaxInFlight];
+                lastSequence = next.lastSequence;
+                next.done.store(false, std::memory_order_relaxed);
+                next.count = 0;
+                next.bytes = 0;
+                ++head_;
+            }
+            if (lastSequence >= 0)
+            {
+                completed_.store(head_, std::memory_order_release);
+                completedSequence_.set(lastSequence);
+            }
+        }
+
+        /**
+         * @brief Writes the rest of a partially completed batch synchronously. Rare, e.g. near a full disk.
+         */
+        int64_t finishShortWrite(Batch &batch, size_t written)
+        {
+            size_t first = 0;
+            while (written >= batch.iov[first].iov_len)
+            {
+                written -= batch.iov[first++].iov_len;
+            }
+            batch.iov[first].iov_base = static_cast<char *>(batch.iov[first].iov_base) + written;
+            batch.iov[first].iov_len -= written;
+
+            uint64_t offset = batch.offset + (batch.bytes - remaining(batch, first));
+            while (first < batch.count)
+            {
+                const ssize_t result = ::pwritev(fd_, &batch.iov[first], static_cast<int>(batch.count - first),
+                                                 static_cast<off_t>(offset));
+                if (result < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    return -errno;
+                }
+                offset += static_cast<size_t>(result);
+                size_t advance = static_cast<size_t>(result);
+                while (first < batch.count && advance >= batch.iov[first].iov_len)
+                {
+                    advance -= batch.iov[first++].iov_len;
+                }
+                if (first < batch.count)
+                {
+                    batch.iov[first].iov_base = static_cast<char *>(batch.iov[first].iov_base) + advance;
+                    batch.iov[first].iov_len -= advance;
+                }
+            }
+            return static_cast<int64_t>(batch.bytes);
+        }
+
+        static size_t remaining(const Batch &batch, size_t first)
+        {
+            size_t bytes = 0;
+            for (size_t i = first; i < batch.count; ++i)
+            {
+                bytes += batch.iov[i].iov_len;
+            }
+            return bytes;
+        }
+    };
+
+} // namespace disruptor
@@ -0,0 +1,232 @@
+/**
+ * @file conflating_publisher.h
+ * @brief Defines latest-value-per-key conflation on top of RingBuffer.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include "event_handler.h"
+#include "sequence.h"
+
+namespace disruptor
+{
+
+    /**
+     * @brief Ring event used in conflating mode: the index of a key in a ConflationTable.
+     */
+    struct ConflatedEvent
+    {
+        size_t key;
+    };
+
+    /**
+     * @brief Latest value per key, shared by a ConflatingPublisher and a ConflatingEventHandler.
+     *
+     * Each entry is a seqlock written by a single producer, plus a pending flag recording whether the
+     * key already has an unconsumed ConflatedEvent in the ring. Keys are dense indices in [0, MaxKeys).
+     *
+     * @tparam T The value type, must be trivially copyable.
+     * @tparam MaxKeys Number of keys.
+     */
+    template <typename T, size_t MaxKeys>
+    class ConflationTable
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Conflated values must be trivially copyable");
+
+    public:
+        ConflationTable() = default;
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        ConflationTable(const ConflationTable &) = delete;
+        ConflationTable &operator=(const ConflationTable &) = delete;
+        ConflationTable(ConflationTable &&) = delete;
+        ConflationTable &operator=(ConflationTable &&) = delete;
+
+        /**
+         * @brief Stores the latest value of a key. Producer side.
+         *
+         * @param key The key index.
+         * @param value The new value.
+         * @return True if the key had no pending notification and one must be published.
+         */
+        bool write(size_t key, const T &value)
+        {
+            Entry &entry = entries_.at(key);
+            const uint64_t version = entry.version.load(std::memory_order_relaxed);
+            entry.version.store(version + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            std::memcpy(&entry.value, &value, sizeof(T));
+            entry.version.store(version + 2, std::memory_order_release);
+
+            return !entry.pending.exchange(true, std::memory_order_acq_rel);
+        }
+
+        /**
+         * @brief Takes the latest value of a key and clears its pending flag. Consumer side.
+         *
+         * A write racing with the read re-arms the flag and publishes again, so no update is lost;
+         * the same value may then be delivered twice.
+         *
+         * @param key The key index.
+         * @param out Receives the value.
+         */
+        void take(size_t key, T &out)
+        {
+            Entry &entry = entries_.at(key);
+            entry.pending.exchange(false, std::memory_order_acq_rel);
+            read(key, out);
+        }
+
+        /**
+         * @brief Reads the latest value of a key without consuming it.
+         *
+         * @param key The key index.
+         * @param out Receives the value.
+         */
+        void read(size_t key, T &out) const
+        {
+            const Entry &entry = entries_.at(key);
+            uint64_t before;
+            uint64_t after;
+            do
+            {
+                before = entry.version.load(std::memory_order_acquire);
+                std::memcpy(&out, &entry.value, sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                after = entry.version.load(std::memory_order_relaxed);
+            } while ((before & 1) != 0 || before != after);
+        }
+
+    private:
+        struct alignas(kSizeOfCacheLine) Entry
+        {
+            std::atomic<uint64_t> version{0};
+            std::atomic<bool> pending{false};
+            T value{};
+        };
+
+        std::array<Entry, MaxKeys> entries_;
+    };
+
+    /**
+     * @brief Producer-side conflation over a RingBuffer of ConflatedEvent.
+     *
+     * Updating a key that is still waiting in the ring only overwrites its table entry, so the
+     * consumer's work per batch is bounded by the number of distinct keys rather than updates.
+     * Single producer only.
+     *
+     * @tparam RingBuffer Ring buffer of ConflatedEvent.
+     * @tparam T The value type.
+     * @tparam MaxKeys Number of keys.
+     */
+    template <typename RingBuffer, typename T, size_t MaxKeys>
+    class ConflatingPublisher
+    {
+    public:
+        /**
+         * @brief Constructs a ConflatingPublisher.
+         *
+         * @param ringBuffer The ring carrying key notifications.
+         * @param table The latest-value table.
+         */
+        ConflatingPublisher(RingBuffer &ringBuffer, ConflationTable<T, MaxKeys> &table)
+            : ringBuffer_(ringBuffer), table_(table) {}
+
+        /**
+         * @brief Publishes the latest value for a key, conflating with any unconsumed update.
+         *
+         * @param key The key index.
+         * @param value The new value.
+         * @return True if a notification was published, false if the update was conflated.
+         */
+        bool publish(size_t key, const T &value)
+        {
+            if (!table_.write(key, value))
+            {
+                ++conflated_;
+                return false;
+            }
+            int64_t sequence = ringBuffer_.next();
+            ringBuffer_.get(sequence).key = key;
+            ringBuffer_.publish(sequence);
+            return true;
+        }
+
+        /**
+         * @brief Gets the number of updates absorbed by conflation.
+         */
+        uint64_t getConflatedCount() const noexcept
+        {
+            return conflated_;
+        }
+
+    private:
+        RingBuffer &ringBuffer_;
+        ConflationTable<T, MaxKeys> &table_;
+        uint64_t conflated_ = 0;
+    };
+
+    /**
+     * @brief Consumer-side adapter turning ConflatedEvent notifications into latest values.
+     *
+     * Only one handler per table may take() values; other consumers can read() without consuming.
+     *
+     * @tparam T The value type.
+     * @tparam MaxKeys Number of keys.
+     * @tparam Handler Handler of T receiving the latest values.
+     */
+    template <typename T, size_t MaxKeys, typename Handler>
+    class ConflatingEventHandler : public EventHandler<ConflatedEvent>
+    {
+    public:
+        /**
+         * @brief Constructs a ConflatingEventHandler.
+         *
+         * @param table The latest-value table.
+         * @param handler The handler receiving values.
+         */
+        ConflatingEventHandler(ConflationTable<T, MaxKeys> &table, Handler &handler)
+            : table_(table), handler_(handler) {}
+
+        void onEvent(ConflatedEvent &event, int64_t sequence, bool endOfBatch) override
+        {
+            table_.take(event.key, value_);
+            handler_.onEvent(value_, sequence, endOfBatch);
+        }
+
+        void onBatchStart(int64_t batchSize, int64_t queueDepth) override
+        {
+            handler_.onBatchStart(batchSize, queueDepth);
+        }
+
+        void onStart() override
+        {
+            handler_.onStart();
+        }
+
+        void onShutdown() override
+        {
+            handler_.onShutdown();
+        }
+
+        void onTimeout(int64_t sequence) override
+        {
+            handler_.onTimeout(sequence);
+        }
+
+    private:
+        ConflationTable<T, MaxKeys> &table_;
+        Handler &handler_;
+        T value_{};
+    };
+
+} // namespace disruptor
@@ -0,0 +1,221 @@
+/**
+ * @file coroutine_event_processor.h
+ * @brief Defines the CoroutineEventProcessor class, an EventProcessor driven by a CoroutineScheduler.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <algorithm>
+#include <stdexcept>
+
+#include "coroutine_scheduler.h"
+#include "event_processor.h"
+#include "exception_handler.h"
+#include "sequence.h"
+#include "sequence_barrier.h"
+
+namespace disruptor
+{
+
+    /**
+     * @brief Coroutine counterpart of EventProcessor.
+     *
+     * run() returns a ProcessorTask to spawn on a CoroutineScheduler. The task awaits
+     * `sequenceBarrier.next(seq)` instead of blocking, so many processors can share one scheduler
+     * thread and are resumed only when their dependent sequences advance. Between batches with a
+     * backlog the task yields, so a busy processor cannot starve the others on its scheduler.
+     *
+     * @tparam T The type of event.
+     * @tparam DataProvider The type providing access to events (e.g., RingBuffer).
+     * @tparam SequenceBarrier The type of barrier used for waiting on sequences.
+     * @tparam EventHandler The type of handler for processing events.
+     * @tparam ExceptionHandlerType The type of exception handler (default: DefaultExceptionHandler).
+     */
+    template <typename T, typename DataProvider, typename SequenceBarrier, typename EventHandler,
+              typename ExceptionHandlerType = DefaultExceptionHandler<T>>
+    class CoroutineEventProcessor
+    {
+    public:
+        /**
+         * @brief Constructs a CoroutineEventProcessor.
+         *
+         * @param dataProvider Reference to the data provider (e.g., ring buffer).
+         * @param sequenceBarrier Reference to the sequence barrier.
+         * @param eventHandler Reference to the event handler.
+         * @param exceptionHandler Reference to the exception handler.
+         * @param batchSize The batch size for processing events (default: 64).
+         */
+        explicit CoroutineEventProcessor(
+            DataProvider &dataProvider,
+            SequenceBarrier &sequenceBarrier,
+            EventHandler &eventHandler,
+            ExceptionHandlerType &exceptionHandler,
+            int64_t batchSize = 64)
+            : dataProvider_(dataProvider),
+              sequenceBarrier_(sequenceBarrier),
+              eventHandler_(eventHandler),
+              exceptionHandler_(exceptionHandler),
+              running_(IDLE),
+              sequence_(-1),
+              batchSizeOffset_(batchSize - 1)
+        {
+            eventHandler_.setSequenceCallback(sequence_);
+        }
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        CoroutineEventProcessor(const CoroutineEventProcessor &) = delete;
+        CoroutineEventProcessor &operator=(const CoroutineEventProcessor &) = delete;
+        CoroutineEventProcessor(CoroutineEventProcessor &&) = delete;
+        CoroutineEventProcessor &operator=(CoroutineEventProcessor &&) = delete;
+
+        /**
+         * @brief Creates the processing task.
+         *
+         * The task transitions the processor to RUNNING when first resumed and completes after halt().
+         *
+         * @return The task, to be spawned on a CoroutineScheduler.
+         */
+        ProcessorTask run()
+        {
+            ProcessorState expected = IDLE;
+            if (!running_.compare_exchange_strong(expected, RUNNING))
+            {
+                throw std::runtime_error("CoroutineEventProcessor already running");
+            }
+            sequenceBarrier_.clearAlert();
+            notifyStart();
+
+            try
+            {
+                int64_t nextSequence = sequence_.get() + 1;
+                while (running_.load(std::memory_order_acquire) == RUNNING)
+                {
+                    try
+                    {
+                        const int64_t availableSequence = co_await sequenceBarrier_.next(nextSequence);
+                        const int64_t endOfBatch = std::min(nextSequence + batchSizeOffset_, availableSequence);
+
+                        if (nextSequence <= endOfBatch)
+                        {
+                            eventHandler_.onBatchStart(endOfBatch - nextSequence + 1, availableSequence - nextSequence + 1);
+                        }
+
+                        while (nextSequence <= endOfBatch)
+                        {
+                            auto &&event = dataProvider_.get(nextSequence);
+                            eventHandler_.onEvent(event, nextSequence, nextSequence == endOfBatch);
+                            ++nextSequence;
+                        }
+                        sequence_.set(endOfBatch);
+
+                        if (availableSequence > endOfBatch)
+                        {
+                            co_await CoroutineScheduler::yield();
+                        }
+                    }
+                    catch (const AlertException &)
+                    {
+                        if (running_.load(std::memory_order_acquire) != RUNNING)
+                        {
+                            break;
+                        }
+                        else
+                        {
+                            throw;
+                        }
+                    }
+                    catch (const std::exception &ex)
+                    {
+                        auto &&event = dataProvider_.get(nextSequence);
+                        exceptionHandler_.handleEventException(ex, nextSequence, event);
+                        sequence_.set(nextSequence);
+                        ++nextSequence;
+                    }
+                }
+            }
+            catch (...)
+            {
+                notifyShutdown();
+                running_.store(IDLE, std::memory_order_release);
+                throw;
+            }
+
+            notifyShutdown();
+            running_.store(IDLE, std::memory_order_release);
+        }
+
+        /**
+         * @brief Halts the processor.
+         *
+         * Sets the state to HALTED and alerts the sequence barrier, which wakes the parked task.
+         */
+        void halt()
+        {
+            running_.store(HALTED, std::memory_order_release);
+            sequenceBarrier_.alert();
+        }
+
+        /**
+         * @brief Checks if the processor is running.
+         *
+         * @return True if the processor is not IDLE, false otherwise.
+         */
+        bool isRunning()
+        {
+            return running_.load(std::memory_order_acquire) != IDLE;
+        }
+
+        /**
+         * @brief Gets the sequence tracker for this processor.
+         *
+         * @return Reference to the sequence object.
+         */
+        Sequence &getSequence()
+        {
+            return sequence_;
+        }
+
+    private:
+        DataProvider &dataProvider_;
+        SequenceBarrier &sequenceBarrier_;
+        EventHandler &eventHandler_;
+        ExceptionHandlerType &exceptionHandler_;
+        std::atomic<ProcessorState> running_;
+        Sequence sequence_;
+        int64_t batchSizeOffset_;
+
+        /**
+         * @brief Notifies the event handler that processing has started.
+         */
+        void notifyStart()
+        {
+            try
+            {
+                eventHandler_.onStart();
+            }
+            catch (const std::exception &ex)
+            {
+                exceptionHandler_.handleOnStartException(ex);
+            }
+        }
+
+        /**
+         * @brief Notifies the event handler that processing is shutting down.
+         */
+        void notifyShutdown()
+        {
+            try
+            {
+                eventHandler_.onShutdown();
+            }
+            catch (const std::exception &ex)
+            {
+                exceptionHandler_.handleOnShutdownException(ex);
+            }
+        }
+    };
+
+} // namespace disruptor
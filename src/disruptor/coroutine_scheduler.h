@@ -0,0 +1,354 @@
+/**
+ * @file coroutine_scheduler.h
+ * @brief Defines the coroutine task type, scheduler and awaitables used to multiplex consumers onto few threads.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "wait_strategies.h"
+
+namespace disruptor
+{
+
+    /**
+     * @brief Coroutine return type for tasks run by a CoroutineScheduler.
+     *
+     * Starts suspended and stays suspended at completion so the scheduler can reap it.
+     * An escaping exception is stored and rethrown by the scheduler.
+     */
+    class ProcessorTask
+    {
+    public:
+        struct promise_type
+        {
+            std::exception_ptr exception;
+
+            ProcessorTask get_return_object() noexcept
+            {
+                return ProcessorTask(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept { exception = std::current_exception(); }
+        };
+
+        explicit ProcessorTask(std::coroutine_handle<promise_type> handle) noexcept
+            : handle_(handle) {}
+
+        /**
+         * @brief Move-only.
+         */
+        ProcessorTask(const ProcessorTask &) = delete;
+        ProcessorTask &operator=(const ProcessorTask &) = delete;
+        ProcessorTask(ProcessorTask &&other) noexcept
+            : handle_(std::exchange(other.handle_, nullptr)) {}
+        ProcessorTask &operator=(ProcessorTask &&other) noexcept
+        {
+            if (this != &other)
+            {
+                destroy();
+                handle_ = std::exchange(other.handle_, nullptr);
+            }
+            return *this;
+        }
+
+        ~ProcessorTask()
+        {
+            destroy();
+        }
+
+        /**
+         * @brief Gets the coroutine handle.
+         */
+        std::coroutine_handle<promise_type> handle() const noexcept
+        {
+            return handle_;
+        }
+
+        /**
+         * @brief Checks if the task has run to completion.
+         */
+        bool done() const noexcept
+        {
+            return !handle_ || handle_.done();
+        }
+
+        /**
+         * @brief Rethrows the exception that ended the task, if any.
+         */
+        void rethrowIfFailed() const
+        {
+            if (handle_ && handle_.promise().exception)
+            {
+                std::rethrow_exception(handle_.promise().exception);
+            }
+        }
+
+    private:
+        std::coroutine_handle<promise_type> handle_;
+
+        void destroy() noexcept
+        {
+            if (handle_)
+            {
+                handle_.destroy();
+                handle_ = nullptr;
+            }
+        }
+    };
+
+    /**
+     * @brief Single-threaded scheduler multiplexing many coroutine tasks.
+     *
+     * Suspended tasks register a readiness check; run() polls the checks and resumes tasks whose
+     * condition holds, so hundreds of consumers can share one thread. Run one scheduler per thread.
+     * spawn() must be called before run() or from the scheduler's own thread.
+     */
+    class CoroutineScheduler
+    {
+    public:
+        using ReadyCheck = bool (*)(const void *context);
+
+        CoroutineScheduler() = default;
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        CoroutineScheduler(const CoroutineScheduler &) = delete;
+        CoroutineScheduler &operator=(const CoroutineScheduler &) = delete;
+        CoroutineScheduler(CoroutineScheduler &&) = delete;
+        CoroutineScheduler &operator=(CoroutineScheduler &&) = delete;
+
+        /**
+         * @brief Takes ownership of a task and queues it to start.
+         *
+         * @param task The task to run.
+         */
+        void spawn(ProcessorTask task)
+        {
+            runnable_.push_back(task.handle());
+            tasks_.push_back(std::move(task));
+        }
+
+        /**
+         * @brief Runs tasks on the calling thread until all have completed or stop() is called.
+         *
+         * Rethrows the first exception escaping a task.
+         */
+        void run()
+        {
+            CoroutineScheduler *previous = std::exchange(current_, this);
+            stopped_.store(false, std::memory_order_release);
+            try
+            {
+                while (!tasks_.empty() && !stopped_.load(std::memory_order_acquire))
+                {
+                    const bool progressed = resumeRunnable() | pollWaiters();
+                    reapCompleted();
+                    if (!progressed)
+                    {
+                        cpu_relax();
+                    }
+                }
+            }
+            catch (...)
+            {
+                current_ = previous;
+                throw;
+            }
+            current_ = previous;
+        }
+
+        /**
+         * @brief Asks run() to return after the current round. Safe to call from any thread.
+         */
+        void stop() noexcept
+        {
+            stopped_.store(true, std::memory_order_release);
+        }
+
+        /**
+         * @brief Gets the scheduler running on the calling thread, or nullptr.
+         */
+        static CoroutineScheduler *current() noexcept
+        {
+            return current_;
+        }
+
+        /**
+         * @brief Gets the scheduler running on the calling thread, for awaitables that must suspend on it.
+         *
+         * @throws std::logic_error If no scheduler is running on this thread, e.g. when a task is
+         *         resumed by hand; the exception is raised inside the awaiting coroutine.
+         */
+        static CoroutineScheduler &running()
+        {
+            if (current_ == nullptr)
+            {
+                throw std::logic_error("Coroutine awaited outside a running CoroutineScheduler");
+            }
+            return *current_;
+        }
+
+        /**
+         * @brief Parks a coroutine until its readiness check returns true.
+         *
+         * @param handle The suspended coroutine.
+         * @param ready The readiness check, polled once per round.
+         * @param context Argument passed to the check.
+         */
+        void park(std::coroutine_handle<> handle, ReadyCheck ready, const void *context)
+        {
+            waiters_.push_back(Waiter{handle, ready, context});
+        }
+
+        /**
+         * @brief Queues a coroutine to resume in the next round.
+         *
+         * @param handle The suspended coroutine.
+         */
+        void schedule(std::coroutine_handle<> handle)
+        {
+            runnable_.push_back(handle);
+        }
+
+        /**
+         * @brief Awaitable that moves the calling task to the back of the run queue.
+         */
+        struct YieldAwaiter
+        {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) const { running().schedule(handle); }
+            void await_resume() const noexcept {}
+        };
+
+        /**
+         * @brief Yields to the other tasks of the current scheduler.
+         */
+        static YieldAwaiter yield() noexcept
+        {
+            return {};
+        }
+
+    private:
+        struct Waiter
+        {
+            std::coroutine_handle<> handle;
+            ReadyCheck ready;
+            const void *context;
+        };
+
+        static inline thread_local CoroutineScheduler *current_ = nullptr;
+
+        std::vector<ProcessorTask> tasks_;
+        std::vector<std::coroutine_handle<>> runnable_;
+        std::vector<std::coroutine_handle<>> resuming_;
+        std::vector<Waiter> waiters_;
+        std::atomic<bool> stopped_{false};
+
+        bool resumeRunnable()
+        {
+            if (runnable_.empty())
+            {
+                return false;
+            }
+            resuming_.swap(runnable_);
+            for (auto handle : resuming_)
+            {
+                handle.resume();
+            }
+            resuming_.clear();
+            return true;
+        }
+
+        bool pollWaiters()
+        {
+            bool progressed = false;
+            for (size_t i = 0; i < waiters_.size();)
+            {
+                if (waiters_[i].ready(waiters_[i].context))
+                {
+                    runnable_.push_back(waiters_[i].handle);
+                    waiters_[i] = waiters_.back();
+                    waiters_.pop_back();
+                    progressed = true;
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+            return progressed;
+        }
+
+        void reapCompleted()
+        {
+            for (size_t i = 0; i < tasks_.size();)
+            {
+                if (tasks_[i].done())
+                {
+                    ProcessorTask task = std::move(tasks_[i]);
+                    tasks_[i] = std::move(tasks_.back());
+                    tasks_.pop_back();
+                    task.rethrowIfFailed();
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief Awaitable returned by SequenceBarrier::next().
+     *
+     * Completes immediately when the sequence is already available; otherwise parks the coroutine on
+     * the current scheduler until it is, or until the barrier is alerted. Resuming yields the highest
+     * available sequence, or throws AlertException.
+     *
+     * @tparam Barrier The sequence barrier type.
+     */
+    template <typename Barrier>
+    class SequenceAwaiter
+    {
+    public:
+        SequenceAwaiter(Barrier &barrier, int64_t sequence) noexcept
+            : barrier_(barrier), sequence_(sequence) {}
+
+        bool await_ready() const
+        {
+            return ready(this);
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) const
+        {
+            CoroutineScheduler::running().park(handle, &SequenceAwaiter::ready, this);
+        }
+
+        int64_t await_resume() const
+        {
+            barrier_.checkAlert();
+            return barrier_.peek(sequence_);
+        }
+
+    private:
+        Barrier &barrier_;
+        int64_t sequence_;
+
+        static bool ready(const void *context)
+        {
+            const auto *self = static_cast<const SequenceAwaiter *>(context);
+            return self->barrier_.isAlerted() || self->barrier_.peek(self->sequence_) >= self->sequence_;
+        }
+    };
+
+} // namespace disruptor
@@ -0,0 +1,247 @@
+/**
+ * @file datagram_ingress.h
+ * @brief Defines the DatagramIngress producer, receiving datagrams with recvmmsg() directly into ring slots.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#include <sys/socket.h>
+#include <sys/types.h>
+
+#include "event_processor.h"
+#include "wait_strategies.h"
+
+namespace disruptor
+{
+
+    /**
+     * @brief Ring event holding one received datagram.
+     *
+     * @tparam Capacity Maximum payload bytes; longer datagrams are truncated and flagged.
+     */
+    template <size_t Capacity>
+    struct Datagram
+    {
+        uint32_t length = 0;
+        bool truncated = false;
+        socklen_t sourceLength = 0;
+        sockaddr_storage source{};
+        std::array<std::byte, Capacity> data{};
+    };
+
+    /**
+     * @brief Producer receiving datagrams straight into the slots of a RingBuffer of Datagram.
+     *
+     * Each poll() checks how many slots are free with hasAvailableCapacity(), points the recvmmsg()
+     * iovecs and source addresses at the slots that the next claim will return, then claims and
+     * publishes only the number of datagrams received with next(n) and publish(lo, hi). Packets are
+     * written once, by the kernel, into their slot. Writing ahead of the claim is safe because
+     * capacity was checked and this is the only producer, so a single-producer sequencer is
+     * required. Kernel drops (SO_RXQ_OVFL, where supported) and truncated datagrams are counted.
+     *
+     * @tparam RingBuffer Ring buffer of Datagram<Capacity>.
+     * @tparam Capacity Maximum payload bytes per datagram.
+     * @tparam MaxBatch Maximum datagrams per recvmmsg() call (default: 64).
+     */
+    template <typename RingBuffer, size_t Capacity, size_t MaxBatch = 64>
+    class DatagramIngress
+    {
+        static_assert(MaxBatch > 0, "MaxBatch must be positive");
+        // slots are written before they are claimed, which another producer could claim first
+        static_assert(RingBuffer::SequencerType::kSingleProducer, "DatagramIngress requires a single-producer sequencer");
+
+    public:
+        /**
+         * @brief Constructs a DatagramIngress.
+         *
+         * @param ringBuffer The ring to publish into, with a single-producer sequencer.
+         * @param fd A bound datagram socket; not owned.
+         */
+        DatagramIngress(RingBuffer &ringBuffer, int fd)
+            : ringBuffer_(ringBuffer),
+              fd_(fd),
+              running_(IDLE)
+        {
+#ifdef SO_RXQ_OVFL
+            const int enable = 1;
+            overflowReported_ = ::setsockopt(fd_, SOL_SOCKET, SO_RXQ_OVFL, &enable, sizeof(enable)) == 0;
+#endif
+        }
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        DatagramIngress(const DatagramIngress &) = delete;
+        DatagramIngress &operator=(const DatagramIngress &) = delete;
+        DatagramIngress(DatagramIngress &&) = delete;
+        DatagramIngress &operator=(DatagramIngress &&) = delete;
+
+        /**
+         * @brief Receives the datagrams already queued on the socket, without blocking.
+         *
+         * @return The number of datagrams published; 0 if none were queued or the ring is full.
+         */
+        int64_t poll()
+        {
+            size_t n = MaxBatch;
+            while (n > 0 && !ringBuffer_.hasAvailableCapacity(static_cast<int64_t>(n)))
+            {
+                n /= 2;
+            }
+            if (n == 0)
+            {
+                return 0;
+            }
+
+            const int64_t first = ringBuffer_.getCursor() + 1;
+            for (size_t i = 0; i < n; ++i)
+            {
+                auto &slot = ringBuffer_.get(first + static_cast<int64_t>(i));
+                iov_[i] = {slot.data.data(), Capacity};
+                headers_[i] = {};
+                headers_[i].msg_hdr.msg_name = &slot.source;
+                headers_[i].msg_hdr.msg_namelen = sizeof(slot.source);
+                headers_[i].msg_hdr.msg_iov = &iov_[i];
+                headers_[i].msg_hdr.msg_iovlen = 1;
+                headers_[i].msg_hdr.msg_control = control_[i].data();
+                headers_[i].msg_hdr.msg_controllen = control_[i].size();
+            }
+
+            const int received = ::recvmmsg(fd_, headers_.data(), static_cast<unsigned>(n), MSG_DONTWAIT, nullptr);
+            if (received < 0)
+            {
+                if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+                {
+                    return 0;
+                }
+                throw std::system_error(errno, std::generic_category(), "recvmmsg");
+            }
+            if (received == 0)
+            {
+                return 0;
+            }
+
+            uint64_t truncated = 0;
+            for (int i = 0; i < received; ++i)
+            {
+                auto &slot = ringBuffer_.get(first + i);
+                const msghdr &header = headers_[i].msg_hdr;
+                slot.length = headers_[i].msg_len;
+                slot.truncated = (header.msg_flags & MSG_TRUNC) != 0;
+                slot.sourceLength = header.msg_namelen;
+                truncated += slot.truncated ? 1 : 0;
+                readOverflow(header);
+            }
+            if (truncated > 0)
+            {
+                truncated_.store(truncated_.load(std::memory_order_relaxed) + truncated, std::memory_order_relaxed);
+            }
+
+            const int64_t hi = ringBuffer_.next(received);
+            ringBuffer_.publish(hi - (received - 1), hi);
+            return received;
+        }
+
+        /**
+         * @brief Polls on the calling thread until halt().
+         */
+        void run()
+        {
+            ProcessorState expected = IDLE;
+            if (!running_.compare_exchange_strong(expected, RUNNING))
+            {
+                throw std::runtime_error("DatagramIngress already running");
+            }
+            try
+            {
+                while (running_.load(std::memory_order_acquire) == RUNNING)
+                {
+                    if (poll() == 0)
+                    {
+                        cpu_relax();
+                    }
+                }
+            }
+            catch (...)
+            {
+                running_.store(IDLE, std::memory_order_release);
+                throw;
+            }
+            running_.store(IDLE, std::memory_order_release);
+        }
+
+        /**
+         * @brief Halts run() after its current poll.
+         */
+        void halt()
+        {
+            running_.store(HALTED, std::memory_order_release);
+        }
+
+        /**
+         * @brief Gets the number of datagrams dropped by the kernel because the socket buffer was full.
+         *
+         * Only counted where SO_RXQ_OVFL is supported, and only as of the last datagram received.
+         * Safe to read from any thread.
+         */
+        uint64_t getDroppedCount() const noexcept
+        {
+            return dropped_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Gets the number of datagrams longer than Capacity. Safe to read from any thread.
+         */
+        uint64_t getTruncatedCount() const noexcept
+        {
+            return truncated_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Checks whether the kernel reports drops on this socket.
+         */
+        bool reportsDrops() const noexcept
+        {
+            return overflowReported_;
+        }
+
+    private:
+        RingBuffer &ringBuffer_;
+        int fd_;
+        std::atomic<ProcessorState> running_;
+        bool overflowReported_ = false;
+        std::atomic<uint64_t> dropped_{0};
+        std::atomic<uint64_t> truncated_{0};
+
+        std::array<mmsghdr, MaxBatch> headers_{};
+        std::array<iovec, MaxBatch> iov_{};
+        std::array<std::array<std::byte, CMSG_SPACE(sizeof(uint32_t))>, MaxBatch> control_{};
+
+        void readOverflow([[maybe_unused]] const msghdr &header)
+        {
+#ifdef SO_RXQ_OVFL
+            for (cmsghdr *cmsg = CMSG_FIRSTHDR(&header); cmsg != nullptr;
+                 cmsg = CMSG_NXTHDR(const_cast<msghdr *>(&header), cmsg))
+            {
+                if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_RXQ_OVFL)
+                {
+                    // the kernel reports its running total for the socket
+                    uint32_t total;
+                    std::memcpy(&total, CMSG_DATA(cmsg), sizeof(total));
+                    dropped_.store(total, std::memory_order_relaxed);
+                }
+            }
+#endif
+        }
+    };
+
+} // namespace disruptor
@@ -0,0 +1,219 @@
+/**
+ * @file egress_handler.h
+ * @brief Defines the EgressHandler, sending a batch of event payloads with one sendmmsg() or writev().
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <system_error>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "event_bytes.h"
+#include "event_handler.h"
+#include "wait_strategies.h"
+
+namespace disruptor
+{
+
+    /**
+     * @brief How an EgressHandler frames payloads on its descriptor.
+     */
+    enum class EgressMode
+    {
+        DATAGRAM = 0, // one datagram per event, flushed with sendmmsg()
+        STREAM = 1,   // payloads concatenated, flushed with writev()
+    };
+
+    /**
+     * @brief Event handler sending event payloads to a socket or stream with few system calls.
+     *
+     * Payloads are gathered as iovecs pointing into the ring slots and flushed at endOfBatch, when
+     * MaxMessages are gathered, or on onTimeout(). A flush returns only once the kernel has accepted
+     * every byte (retrying partial writes and spinning on EAGAIN), so the processor's Sequence, which
+     * advances after the batch, never releases a slot the kernel still references.
+     *
+     * @tparam T The type of event.
+     * @tparam Payload Callable returning the bytes to send for an event, which must live in the slot
+     *                 (default: EventBytes<T>).
+     * @tparam MaxMessages Maximum payloads per flush (default: 64).
+     */
+    template <typename T, typename Payload = EventBytes<T>, size_t MaxMessages = 64>
+    class EgressHandler : public EventHandler<T>
+    {
+        static_assert(MaxMessages > 0 && MaxMessages <= IOV_MAX, "MaxMessages must be in [1, IOV_MAX]");
+
+    public:
+        /**
+         * @brief Constructs an EgressHandler.
+         *
+         * @param fd A connected socket (DATAGRAM) or a stream descriptor (STREAM); not owned.
+         * @param mode The framing mode.
+         * @param payload Callable returning the bytes of an event.
+         */
+        EgressHandler(int fd, EgressMode mode, Payload payload = Payload{})
+            : fd_(fd),
+              mode_(mode),
+              payload_(std::move(payload)) {}
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        EgressHandler(const EgressHandler &) = delete;
+        EgressHandler &operator=(const EgressHandler &) = delete;
+        EgressHandler(EgressHandler &&) = delete;
+        EgressHandler &operator=(EgressHandler &&) = delete;
+
+        void onEvent(T &event, int64_t sequence, bool endOfBatch) override
+        {
+            assert(count_ < MaxMessages);
+            const std::span<const std::byte> bytes = payload_(event);
+            iov_[count_++] = {const_cast<std::byte *>(bytes.data()), bytes.size()};
+
+            if (count_ == MaxMessages || endOfBatch)
+            {
+                flush();
+            }
+        }
+
+        void onTimeout(int64_t sequence) override
+        {
+            flush();
+        }
+
+        void onShutdown() override
+        {
+            flush();
+        }
+
+        /**
+         * @brief Gets the number of messages sent. Safe to read from any thread.
+         */
+        uint64_t getMessageCount() const noexcept
+        {
+            return messages_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Gets the number of send system calls made. Safe to read from any thread.
+         */
+        uint64_t getSyscallCount() const noexcept
+        {
+            return syscalls_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        int fd_;
+        EgressMode mode_;
+        Payload payload_;
+        std::array<iovec, MaxMessages> iov_{};
+        std::array<mmsghdr, MaxMessages> headers_{};
+        size_t count_ = 0;
+        std::atomic<uint64_t> messages_{0};
+        std::atomic<uint64_t> syscalls_{0};
+
+        void flush()
+        {
+            if (count_ == 0)
+            {
+                return;
+            }
+            try
+            {
+                if (mode_ == EgressMode::DATAGRAM)
+                {
+                    sendDatagrams();
+                }
+                else
+                {
+                    writeStream();
+                }
+            }
+            catch (...)
+            {
+                // the gathered iovecs point into slots released once the exception is handled
+                count_ = 0;
+                throw;
+            }
+            // single writer, so a plain load/store avoids a locked increment
+            messages_.store(messages_.load(std::memory_order_relaxed) + count_, std::memory_order_relaxed);
+            count_ = 0;
+        }
+
+        void sendDatagrams()
+        {
+            for (size_t i = 0; i < count_; ++i)
+            {
+                headers_[i] = {};
+                headers_[i].msg_hdr.msg_iov = &iov_[i];
+                headers_[i].msg_hdr.msg_iovlen = 1;
+            }
+            size_t sent = 0;
+            while (sent < count_)
+            {
+                const int result = ::sendmmsg(fd_, &headers_[sent], static_cast<unsigned>(count_ - sent), 0);
+                countSyscall();
+                if (result < 0)
+                {
+                    retryOrThrow("sendmmsg");
+                    continue;
+                }
+                sent += static_cast<size_t>(result);
+            }
+        }
+
+        void writeStream()
+        {
+            size_t first = 0;
+            while (first < count_)
+            {
+                const ssize_t result = ::writev(fd_, &iov_[first], static_cast<int>(count_ - first));
+                countSyscall();
+                if (result < 0)
+                {
+                    retryOrThrow("writev");
+                    continue;
+                }
+                // skip what was written, resuming mid-payload after a partial write
+                size_t written = static_cast<size_t>(result);
+                while (first < count_ && written >= iov_[first].iov_len)
+                {
+                    written -= iov_[first++].iov_len;
+                }
+                if (first < count_)
+                {
+                    iov_[first].iov_base = static_cast<char *>(iov_[first].iov_base) + written;
+                    iov_[first].iov_len -= written;
+                }
+            }
+        }
+
+        void retryOrThrow(const char *call)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+            {
+                cpu_relax();
+            }
+            else if (errno != EINTR)
+            {
+                throw std::system_error(errno, std::generic_category(), call);
+            }
+        }
+
+        void countSyscall() noexcept
+        {
+            syscalls_.store(syscalls_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    };
+
+} // namespace disruptor
@@ -0,0 +1,34 @@
+/**
+ * @file event_bytes.h
+ * @brief Defines EventBytes, the default payload projection of the I/O handlers.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+namespace disruptor
+{
+
+    /**
+     * @brief Payload projection returning the bytes of the event itself.
+     *
+     * I/O handlers take a projection returning the bytes to write for an event; the bytes must live
+     * in the ring slot, since they are referenced rather than copied.
+     *
+     * @tparam T The event type, must be trivially copyable.
+     */
+    template <typename T>
+    struct EventBytes
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "EventBytes needs a trivially copyable event");
+
+        std::span<const std::byte> operator()(const T &event) const
+        {
+            return std::as_bytes(std::span<const T, 1>(&event, 1));
+        }
+    };
+
+} // namespace disruptor
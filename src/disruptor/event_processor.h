@@ -7,12 +7,14 @@
 
 #include <atomic>
 #include <algorithm>
+#include <cstdint>
 #include <stdexcept>
 
 #include "sequence.h"
 #include "sequencer.h"
 #include "sequence_barrier.h"
 #include "exception_handler.h"
+#include "gating_group.h"
 
 namespace disruptor
 {
@@ -27,6 +29,17 @@ namespace disruptor
         RUNNING = 2,
     };
 
+    /**
+     * @brief Counters of the batches an event processor has handled.
+     */
+    struct BatchStats
+    {
+        uint64_t batches = 0;
+        uint64_t events = 0;
+        uint64_t maxBatch = 0;  // largest batch so far
+        uint64_t lastBatch = 0; // size of the most recent batch
+    };
+
     /**
      * @brief Template class for processing events in the disruptor pattern.
      *
@@ -52,20 +65,23 @@ namespace disruptor
          * @param eventHandler Reference to the event handler.
          * @param exceptionHandler Reference to the exception handler.
          * @param batchSize The batch size for processing events (default: 64).
+         * @param prefetchDistance How many slots ahead of the current one to prefetch, 0 disables (default: 0).
          */
         explicit EventProcessor(
             DataProvider &dataProvider,
             SequenceBarrier &sequenceBarrier,
             EventHandler &eventHandler,
             ExceptionHandlerType &exceptionHandler,
-            int64_t batchSize = 64)
+            int64_t batchSize = 64,
+            int64_t prefetchDistance = 0)
             : dataProvider_(dataProvider),
               sequenceBarrier_(sequenceBarrier),
               eventHandler_(eventHandler),
               exceptionHandler_(exceptionHandler),
               running_(IDLE),
               sequence_(-1),
-              batchSizeOffset_(batchSize - 1)
+              batchSizeOffset_(batchSize - 1),
+              prefetchDistance_(prefetchDistance)
         {
             eventHandler_.setSequenceCallback(sequence_);
         }
@@ -141,6 +157,39 @@ namespace disruptor
             return running_.load(std::memory_order_acquire) != IDLE;
         }
 
+        /**
+         * @brief Gets the processor state. Safe to call from any thread.
+         */
+        ProcessorState getState() const noexcept
+        {
+            return running_.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Gets the batch counters. Lock-free, safe to call from any thread or a signal handler.
+         *
+         * Each counter is read on its own, so they may be one batch apart while the processor runs.
+         */
+        BatchStats getBatchStats() const noexcept
+        {
+            return {batches_.load(std::memory_order_relaxed),
+                    events_.load(std::memory_order_relaxed),
+                    maxBatch_.load(std::memory_order_relaxed),
+                    lastBatch_.load(std::memory_order_relaxed)};
+        }
+
+        /**
+         * @brief Makes this processor report its progress to a gating group.
+         *
+         * Must be called before run().
+         *
+         * @param group The group this processor's sequence is a member of.
+         */
+        void setGatingGroup(GatingGroup &group)
+        {
+            gatingGroup_ = &group;
+        }
+
         /**
          * @brief Gets the sequence tracker for this processor.
          *
@@ -159,6 +208,12 @@ namespace disruptor
         std::atomic<ProcessorState> running_;
         Sequence sequence_;
         int64_t batchSizeOffset_;
+        int64_t prefetchDistance_;
+        GatingGroup *gatingGroup_ = nullptr;
+        std::atomic<uint64_t> batches_{0};
+        std::atomic<uint64_t> events_{0};
+        std::atomic<uint64_t> maxBatch_{0};
+        std::atomic<uint64_t> lastBatch_{0};
 
         /**
          * @brief Main loop for processing events.
@@ -173,6 +228,7 @@ namespace disruptor
                 try
                 {
                     const int64_t availableSequence = sequenceBarrier_.waitFor(nextSequence);
+                    const int64_t previous = nextSequence - 1;
                     const int64_t endOfBatch = std::min(nextSequence + batchSizeOffset_, availableSequence);
 
                     if (nextSequence <= endOfBatch)
@@ -182,11 +238,15 @@ namespace disruptor
 
                     while (nextSequence <= endOfBatch)
                     {
-                        T &event = dataProvider_.get(nextSequence);
+                        prefetch(nextSequence + prefetchDistance_, availableSequence);
+                        // bind by forwarding reference so proxy-returning providers (SoARingBuffer) work too
+                        auto &&event = dataProvider_.get(nextSequence);
                         eventHandler_.onEvent(event, nextSequence, nextSequence == endOfBatch);
                         ++nextSequence;
                     }
                     sequence_.set(endOfBatch);
+                    notifyGatingGroup(previous);
+                    recordBatch(endOfBatch - previous);
                 }
                 catch (const AlertException &)
                 {
@@ -201,13 +261,70 @@ namespace disruptor
                 }
                 catch (const std::exception &ex)
                 {
-                    exceptionHandler_.handleEventException(ex, nextSequence, dataProvider_.get(nextSequence));
+                    auto &&event = dataProvider_.get(nextSequence);
+                    exceptionHandler_.handleEventException(ex, nextSequence, event);
+                    const int64_t previous = sequence_.get();
                     sequence_.set(nextSequence);
+                    notifyGatingGroup(previous);
                     ++nextSequence;
                 }
             }
         }
 
+        /**
+         * @brief Prefetches an upcoming slot if prefetching is enabled and the slot is published.
+         *
+         * Only data providers exposing prefetch(sequence) are prefetched.
+         *
+         * @param sequence The sequence to prefetch.
+         * @param availableSequence The highest sequence available to this processor.
+         */
+        void prefetch(int64_t sequence, int64_t availableSequence) const
+        {
+            if constexpr (requires { dataProvider_.prefetch(sequence); })
+            {
+                if (prefetchDistance_ > 0 && sequence <= availableSequence)
+                {
+                    dataProvider_.prefetch(sequence);
+                }
+            }
+        }
+
+        /**
+         * @brief Updates the batch counters.
+         *
+         * @param size The number of events in the batch, 0 if none.
+         */
+        void recordBatch(int64_t size) noexcept
+        {
+            if (size <= 0)
+            {
+                return;
+            }
+            const uint64_t events = static_cast<uint64_t>(size);
+            // single writer, so a plain load/store avoids a locked increment
+            batches_.store(batches_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            events_.store(events_.load(std::memory_order_relaxed) + events, std::memory_order_relaxed);
+            lastBatch_.store(events, std::memory_order_relaxed);
+            if (events > maxBatch_.load(std::memory_order_relaxed))
+            {
+                maxBatch_.store(events, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Reports a sequence update to the gating group, if any.
+         *
+         * @param previous The sequence value before the update.
+         */
+        void notifyGatingGroup(int64_t previous)
+        {
+            if (gatingGroup_ != nullptr)
+            {
+                gatingGroup_->onMemberAdvanced(previous);
+            }
+        }
+
         /**
          * @brief Notifies the event handler of a timeout.
          *
@@ -0,0 +1,170 @@
+/**
+ * @file gating_group.h
+ * @brief Defines the GatingGroup class, aggregating many consumer sequences into one gating sequence.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "sequence.h"
+#include "sequence_group.h"
+
+namespace disruptor
+{
+
+    /**
+     * @brief Maintains the minimum of a group of consumer sequences in a single Sequence.
+     *
+     * With wide fan-out the producer would otherwise scan one cache line per consumer each time its
+     * cached gating value runs out. Instead each group is gated by getSequence(), so the producer reads
+     * one line per group. Members report progress through onMemberAdvanced(); only a member that was
+     * holding the group minimum rescans the group, so the cost falls on the slowest consumer.
+     *
+     * A group is never empty: with no member left to advance it, its minimum would freeze and stall the
+     * producer one ring later. Remove the group's sequence from the sequencer to retire it instead.
+     */
+    class GatingGroup
+    {
+    public:
+        /**
+         * @brief Constructs a GatingGroup.
+         *
+         * @param members The consumer sequences of the group, at least one.
+         * @param initial Initial group minimum (default: -1, matching a fresh Sequence).
+         */
+        explicit GatingGroup(const std::vector<Sequence *> &members, int64_t initial = -1)
+            : minimum_(initial), members_(members)
+        {
+            if (members.empty())
+            {
+                throw std::invalid_argument("GatingGroup requires at least one member");
+            }
+        }
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        GatingGroup(const GatingGroup &) = delete;
+        GatingGroup &operator=(const GatingGroup &) = delete;
+        GatingGroup(GatingGroup &&) = delete;
+        GatingGroup &operator=(GatingGroup &&) = delete;
+
+        /**
+         * @brief Gets the group minimum, to be registered as a gating sequence with the sequencer.
+         *
+         * @return Reference to the aggregated sequence.
+         */
+        Sequence &getSequence() noexcept
+        {
+            return minimum_;
+        }
+
+        /**
+         * @brief Adds members while the group is in use.
+         *
+         * New members start at the cursor, which is never behind the group minimum.
+         *
+         * @param members The sequences to add.
+         * @param cursor The cursor the new members start from.
+         */
+        void addMembers(const std::vector<Sequence *> &members, const Sequence &cursor)
+        {
+            members_.add(members, cursor);
+        }
+
+        /**
+         * @brief Removes a member while the group is in use.
+         *
+         * Rescans the group, since the removed member may have been holding the minimum back.
+         *
+         * @param member The sequence to remove.
+         * @return True if the sequence was a member.
+         * @throws std::logic_error If the sequence is the last member.
+         */
+        bool removeMember(const Sequence &member)
+        {
+            std::lock_guard<std::mutex> lock(removeMutex_);
+            const auto members = members_.get();
+            if (members.size() == 1 && members.front() == &member)
+            {
+                throw std::logic_error("Cannot remove the last member of a GatingGroup");
+            }
+            const bool removed = members_.remove(member);
+            if (removed)
+            {
+                update();
+            }
+            return removed;
+        }
+
+        /**
+         * @brief Called by a member after it has set its sequence.
+         *
+         * @param previous The member's sequence value before the update.
+         */
+        void onMemberAdvanced(int64_t previous)
+        {
+            // orders the member's release store before the loads below; without it two members at the
+            // minimum can each miss the other's advance and both skip the rescan, stalling the group
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            // members above the group minimum cannot raise it
+            if (previous <= minimum_.get())
+            {
+                update();
+            }
+        }
+
+        /**
+         * @brief Rescans the members and raises the group minimum.
+         *
+         * The minimum only ever moves forward. The scan repeats if the slowest member moved while the
+         * result was being published, so a member that skipped its own rescan is never left behind.
+         */
+        void update()
+        {
+            while (true)
+            {
+                auto members = members_.get();
+                if (members.empty())
+                {
+                    return;
+                }
+                int64_t min = std::numeric_limits<int64_t>::max();
+                const Sequence *slowest = members.front();
+                for (const auto *seq : members)
+                {
+                    int64_t seqValue = seq->get();
+                    if (seqValue < min)
+                    {
+                        min = seqValue;
+                        slowest = seq;
+                    }
+                }
+
+                int64_t current = minimum_.get();
+                while (current < min && !minimum_.compareAndSet(current, min))
+                {
+                }
+                // pairs with the fence in onMemberAdvanced: either the slowest member sees the new
+                // minimum and rescans itself, or its advance is visible to the check below
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                if (slowest->get() == min)
+                {
+                    return;
+                }
+            }
+        }
+
+    private:
+        Sequence minimum_;
+        SequenceGroup members_;
+        std::mutex removeMutex_; // makes the last-member check and the removal one step
+    };
+
+} // namespace disruptor
@@ -0,0 +1,414 @@
+/**
+ * @file journal.h
+ * @brief Defines the on-disk journal format and the JournalHandler, a memory-mapped journaling event handler.
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "event_handler.h"
+#include "sequence.h"
+
+namespace disruptor
+{
+
+    constexpr uint64_t kJournalMagic = 0x4c4e524a52505344; // "DSPRJRNL"
+    constexpr uint32_t kJournalVersion = 1;
+
+    /**
+     * @brief Header at the start of every journal segment.
+     *
+     * committed is the number of durable records; it is only advanced once those records are synced,
+     * so a reader never trusts records past it.
+     */
+    struct alignas(kSizeOfCacheLine) JournalSegmentHeader
+    {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t recordSize;
+        int64_t firstSequence;
+        uint64_t capacity;
+        uint64_t committed;
+    };
+
+    /**
+     * @brief One journaled event.
+     *
+     * @tparam T The event type.
+     */
+    template <typename T>
+    struct JournalRecord
+    {
+        int64_t sequence;
+        int64_t timestampNs; // wall clock at journaling time, used for paced replay
+        T event;
+    };
+
+    /**
+     * @brief Builds the path of the segment starting at a sequence.
+     *
+     * Names sort in sequence order.
+     *
+     * @param directory The journal directory.
+     * @param firstSequence First sequence stored in the segment.
+     * @return The segment path.
+     */
+    inline std::filesystem::path journalSegmentPath(const std::filesystem::path &directory, int64_t firstSequence)
+    {
+        char name[48];
+        std::snprintf(name, sizeof(name), "journal-%020lld.seg", static_cast<long long>(firstSequence));
+        return directory / name;
+    }
+
+    /**
+     * @brief Event handler persisting every event to memory-mapped, pre-allocated segment files.
+     *
+     * Records are copied into the mapping in onEvent(); at endOfBatch the header's committed count is
+     * updated and the written range is synced, so one msync covers the whole batch (group commit).
+     * Because the processor only advances its Sequence after the batch, processors gated on
+     * getSequence() never see an event before it is durable, as in the diamond of main.cpp.
+     * Segments roll when full. Their blocks are allocated when they are created, so running out of disk
+     * space throws there rather than faulting on a write to the mapping. An existing segment is never
+     * overwritten. A restarted process resumes the directory instead: records carry journal sequences,
+     * which continue from the last committed record found on disk while ring sequences restart at 0, so
+     * the directory replays as one run. journalSequence() maps a ring sequence of this run onto them.
+     *
+     * @tparam T The event type, must be trivially copyable.
+     */
+    template <typename T>
+    class JournalHandler : public EventHandler<T>
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Journaled events must be trivially copyable");
+
+    public:
+        using Record = JournalRecord<T>;
+
+        /**
+         * @brief Constructs a JournalHandler.
+         *
+         * @param directory Directory holding the segments, created if missing.
+         * @param recordsPerSegment Capacity of each segment file.
+         */
+        JournalHandler(std::filesystem::path directory, uint64_t recordsPerSegment)
+            : directory_(std::move(directory)),
+              recordsPerSegment_(recordsPerSegment)
+        {
+            if (recordsPerSegment == 0)
+            {
+                throw std::invalid_argument("Invalid recordsPerSegment in JournalHandler");
+            }
+            std::filesystem::create_directories(directory_);
+            resume();
+        }
+
+        ~JournalHandler() override
+        {
+            try
+            {
+                closeSegment();
+            }
+            catch (...)
+            {
+            }
+        }
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        JournalHandler(const JournalHandler &) = delete;
+        JournalHandler &operator=(const JournalHandler &) = delete;
+        JournalHandler(JournalHandler &&) = delete;
+        JournalHandler &operator=(JournalHandler &&) = delete;
+
+        void onEvent(T &event, int64_t sequence, bool endOfBatch) override
+        {
+            if (!started_)
+            {
+                offset_ = next_ - sequence;
+                started_ = true;
+            }
+            if (header_ == nullptr || header_->committed + pending_ == header_->capacity)
+            {
+                rollSegment(journalSequence(sequence));
+            }
+
+            Record *record = records_ + header_->committed + pending_;
+            record->sequence = journalSequence(sequence);
+            record->timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                      std::chrono::system_clock::now().time_since_epoch())
+                                      .count();
+            std::memcpy(&record->event, &event, sizeof(T));
+            ++pending_;
+
+            if (endOfBatch)
+            {
+                commit();
+            }
+        }
+
+        void onShutdown() override
+        {
+            closeSegment();
+        }
+
+        void setSequenceCallback(Sequence &sequenceCallback) override
+        {
+            sequence_ = &sequenceCallback;
+        }
+
+        /**
+         * @brief Gets the sequence of the processor running this handler.
+         *
+         * Everything up to it is durable; gate business-logic processors behind it.
+         *
+         * @return Reference to the sequence.
+         */
+        Sequence &getSequence()
+        {
+            if (sequence_ == nullptr)
+            {
+                throw std::logic_error("JournalHandler is not attached to a processor");
+            }
+            return *sequence_;
+        }
+
+        /**
+         * @brief Maps a ring sequence of this run onto the journal sequence it is recorded under.
+         *
+         * Only meaningful once the first event has been journaled; replay the journal from the result,
+         * e.g. for a snapshot taken by this run.
+         *
+         * @param sequence The ring sequence.
+         * @return The journal sequence.
+         */
+        int64_t journalSequence(int64_t sequence) const
+        {
+            return sequence + offset_;
+        }
+
+        /**
+         * @brief Makes every written record durable.
+         */
+        void commit()
+        {
+            if (header_ == nullptr || pending_ == 0)
+            {
+                return;
+            }
+            const size_t begin = offsetOf(header_->committed);
+            const size_t end = offsetOf(header_->committed + pending_);
+
+            // records before the count that covers them, so a torn commit only loses the batch
+            sync(begin, end - begin);
+            header_->committed += pending_;
+            pending_ = 0;
+            sync(0, sizeof(JournalSegmentHeader));
+        }
+
+    private:
+        std::filesystem::path directory_;
+        uint64_t recordsPerSegment_;
+        int fd_ = -1;
+        void *mapping_ = nullptr;
+        size_t mappingSize_ = 0;
+        JournalSegmentHeader *header_ = nullptr;
+        Record *records_ = nullptr;
+        uint64_t pending_ = 0;
+        Sequence *sequence_ = nullptr;
+        int64_t next_ = 0;   // journal sequence of the first record of this run
+        int64_t offset_ = 0; // journal sequence minus ring sequence
+        bool started_ = false;
+
+        static size_t offsetOf(uint64_t record)
+        {
+            return sizeof(JournalSegmentHeader) + record * sizeof(Record);
+        }
+
+        void sync(size_t offset, size_t length)
+        {
+            static const size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            const size_t aligned = offset & ~(pageSize - 1);
+            if (::msync(static_cast<char *>(mapping_) + aligned, length + (offset - aligned), MS_SYNC) != 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "msync journal segment");
+            }
+        }
+
+        /**
+         * @brief Finds where a previous run stopped, from the header of the last segment.
+         *
+         * A trailing segment with nothing committed is removed, as a crash while rolling may have left
+         * it behind, and its name is reused.
+         */
+        void resume()
+        {
+            int64_t lastFirst = -1;
+            std::filesystem::path lastPath;
+            for (const auto &entry : std::filesystem::directory_iterator(directory_))
+            {
+                const std::string name = entry.path().filename().string();
+                if (name.starts_with("journal-") && name.ends_with(".seg"))
+                {
+                    const int64_t first = std::stoll(name.substr(8, name.size() - 12));
+                    if (first > lastFirst)
+                    {
+                        lastFirst = first;
+                        lastPath = entry.path();
+                    }
+                }
+            }
+            if (lastFirst < 0)
+            {
+                return;
+            }
+
+            const int fd = ::open(lastPath.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "open journal segment " + lastPath.string());
+            }
+            JournalSegmentHeader header;
+            const ssize_t size = ::pread(fd, &header, sizeof(header), 0);
+            const int error = errno;
+            ::close(fd);
+            if (size < 0)
+            {
+                throw std::system_error(error, std::generic_category(), "read journal segment " + lastPath.string());
+            }
+            // a header still zeroed from allocation was never initialised, so it holds no records either
+            const bool unwritten = size == static_cast<ssize_t>(sizeof(header)) && header.magic == 0;
+            if (!unwritten &&
+                (size != static_cast<ssize_t>(sizeof(header)) || header.magic != kJournalMagic ||
+                 header.version != kJournalVersion || header.recordSize != sizeof(Record)))
+            {
+                throw std::runtime_error("Invalid journal segment " + lastPath.string());
+            }
+
+            if (unwritten || header.committed == 0)
+            {
+                ::unlink(lastPath.c_str());
+                next_ = lastFirst;
+                return;
+            }
+            next_ = lastFirst + static_cast<int64_t>(header.committed);
+        }
+
+        void rollSegment(int64_t firstSequence)
+        {
+            closeSegment();
+
+            const auto path = journalSegmentPath(directory_, firstSequence);
+            // never reuse a name: ring sequences restart at 0, so an existing segment holds committed records
+            fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+            if (fd_ < 0)
+            {
+                if (errno == EEXIST)
+                {
+                    throw std::runtime_error("Journal segment already exists, refusing to overwrite " + path.string());
+                }
+                throw std::system_error(errno, std::generic_category(), "open journal segment " + path.string());
+            }
+
+            // allocate every block up front: a sparse file would allocate on first write to the mapping,
+            // and a full disk would then raise SIGBUS on the processor thread instead of failing here
+            mappingSize_ = offsetOf(recordsPerSegment_);
+            const int allocateError = ::posix_fallocate(fd_, 0, static_cast<off_t>(mappingSize_));
+            if (allocateError != 0)
+            {
+                discardSegment(path);
+                throw std::system_error(allocateError, std::generic_category(), "allocate journal segment " + path.string());
+            }
+            // the size and extents, then the directory entry, so the segment survives a crash
+            if (::fsync(fd_) != 0)
+            {
+                const int syncError = errno;
+                discardSegment(path);
+                throw std::system_error(syncError, std::generic_category(), "sync journal segment " + path.string());
+            }
+            try
+            {
+                syncDirectory();
+            }
+            catch (...)
+            {
+                discardSegment(path);
+                throw;
+            }
+
+            mapping_ = ::mmap(nullptr, mappingSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+            if (mapping_ == MAP_FAILED)
+            {
+                const int error = errno;
+                mapping_ = nullptr;
+                discardSegment(path);
+                throw std::system_error(error, std::generic_category(), "mmap journal segment " + path.string());
+            }
+
+            header_ = static_cast<JournalSegmentHeader *>(mapping_);
+            records_ = reinterpret_cast<Record *>(static_cast<char *>(mapping_) + sizeof(JournalSegmentHeader));
+            header_->magic = kJournalMagic;
+            header_->version = kJournalVersion;
+            header_->recordSize = sizeof(Record);
+            header_->firstSequence = firstSequence;
+            header_->capacity = recordsPerSegment_;
+            header_->committed = 0;
+            pending_ = 0;
+            sync(0, sizeof(JournalSegmentHeader));
+        }
+
+        // a half-built segment is removed so that a retry can create it again under O_EXCL
+        void discardSegment(const std::filesystem::path &path)
+        {
+            closeSegment();
+            ::unlink(path.c_str());
+        }
+
+        void syncDirectory()
+        {
+            const int fd = ::open(directory_.c_str(), O_RDONLY | O_DIRECTORY);
+            if (fd < 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "open journal directory " + directory_.string());
+            }
+            const int result = ::fsync(fd);
+            const int error = errno;
+            ::close(fd);
+            if (result != 0)
+            {
+                throw std::system_error(error, std::generic_category(), "sync journal directory " + directory_.string());
+            }
+        }
+
+        void closeSegment()
+        {
+            if (mapping_ != nullptr)
+            {
+                commit();
+                ::munmap(mapping_, mappingSize_);
+                mapping_ = nullptr;
+                header_ = nullptr;
+                records_ = nullptr;
+            }
+            if (fd_ >= 0)
+            {
+                ::close(fd_);
+                fd_ = -1;
+            }
+        }
+    };
+
+} // namespace disruptor
@@ -0,0 +1,320 @@
+/**
+ * @file journal_replayer.h
+ * @brief Defines the JournalReplayer class, publishing journal segments back into a RingBuffer.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "journal.h"
+#include "tsc_clock.h"
+#include "wait_strategies.h"
+
+namespace disruptor
+{
+
+    /**
+     * @brief How a JournalReplayer spaces out publication.
+     */
+    enum class ReplayPacing
+    {
+        AS_FAST_AS_POSSIBLE = 0, // publish as fast as the ring accepts
+        ORIGINAL = 1,            // reproduce the journaled inter-arrival times
+        SCALED = 2,              // original inter-arrival times divided by the speed factor
+    };
+
+    /**
+     * @brief Read-only mapping of one committed journal segment.
+     *
+     * @tparam T The event type.
+     */
+    template <typename T>
+    class JournalSegmentReader
+    {
+    public:
+        using Record = JournalRecord<T>;
+
+        /**
+         * @brief Maps a segment and validates its header.
+         *
+         * @param path The segment file.
+         */
+        explicit JournalSegmentReader(const std::filesystem::path &path)
+        {
+            fd_ = ::open(path.c_str(), O_RDONLY);
+            if (fd_ < 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "open journal segment " + path.string());
+            }
+            struct stat status;
+            if (::fstat(fd_, &status) != 0)
+            {
+                const int error = errno;
+                ::close(fd_);
+                throw std::system_error(error, std::generic_category(), "stat journal segment " + path.string());
+            }
+            size_ = static_cast<size_t>(status.st_size);
+            if (size_ < sizeof(JournalSegmentHeader))
+            {
+                ::close(fd_);
+                throw std::runtime_error("Truncated journal segment " + path.string());
+            }
+
+            mapping_ = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+            if (mapping_ == MAP_FAILED)
+            {
+                const int error = errno;
+                ::close(fd_);
+                throw std::system_error(error, std::generic_category(), "mmap journal segment " + path.string());
+            }
+            ::madvise(mapping_, size_, MADV_SEQUENTIAL);
+
+            header_ = static_cast<const JournalSegmentHeader *>(mapping_);
+            if (header_->magic != kJournalMagic || header_->version != kJournalVersion ||
+                header_->recordSize != sizeof(Record) ||
+                sizeof(JournalSegmentHeader) + header_->committed * sizeof(Record) > size_)
+            {
+                ::munmap(mapping_, size_);
+                ::close(fd_);
+                throw std::runtime_error("Invalid journal segment " + path.string());
+            }
+        }
+
+        ~JournalSegmentReader()
+        {
+            ::munmap(mapping_, size_);
+            ::close(fd_);
+        }
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        JournalSegmentReader(const JournalSegmentReader &) = delete;
+        JournalSegmentReader &operator=(const JournalSegmentReader &) = delete;
+        JournalSegmentReader(JournalSegmentReader &&) = delete;
+        JournalSegmentReader &operator=(JournalSegmentReader &&) = delete;
+
+        /**
+         * @brief Gets the committed records.
+         */
+        const Record *begin() const
+        {
+            return reinterpret_cast<const Record *>(static_cast<const char *>(mapping_) + sizeof(JournalSegmentHeader));
+        }
+
+        const Record *end() const
+        {
+            return begin() + header_->committed;
+        }
+
+    private:
+        int fd_ = -1;
+        void *mapping_ = nullptr;
+        size_t size_ = 0;
+        const JournalSegmentHeader *header_ = nullptr;
+    };
+
+    /**
+     * @brief Producer replaying a journal directory into a RingBuffer.
+     *
+     * Segments are read through read-only mappings and published with batched next(n) claims and one
+     * publish(lo, hi) per batch, so recovery runs at ring speed rather than at one claim per event.
+     * Events get new ring sequences; handlers needing the journaled sequence must carry it in T.
+     * Single producer only.
+     *
+     * @tparam RingBuffer The ring buffer type.
+     * @tparam T The event type, as journaled by JournalHandler<T>.
+     */
+    template <typename RingBuffer, typename T>
+    class JournalReplayer
+    {
+    public:
+        using Record = JournalRecord<T>;
+
+        /**
+         * @brief Constructs a JournalReplayer.
+         *
+         * @param ringBuffer The ring to publish into.
+         * @param directory The journal directory.
+         * @param pacing The rate control mode (default: AS_FAST_AS_POSSIBLE).
+         * @param speed For SCALED, the speed-up over the original timing (default: 1.0).
+         * @param batchSize Maximum events per claim (default: 64), clamped to the ring size.
+         */
+        JournalReplayer(
+            RingBuffer &ringBuffer,
+            std::filesystem::path directory,
+            ReplayPacing pacing = ReplayPacing::AS_FAST_AS_POSSIBLE,
+            double speed = 1.0,
+            int64_t batchSize = 64)
+            : ringBuffer_(ringBuffer),
+              directory_(std::move(directory)),
+              pacing_(pacing),
+              speed_(pacing == ReplayPacing::ORIGINAL ? 1.0 : speed),
+              batchSize_(std::min<int64_t>(batchSize, static_cast<int64_t>(RingBuffer::kBufferSize)))
+        {
+            if (batchSize < 1)
+            {
+                throw std::invalid_argument("Invalid batchSize in JournalReplayer");
+            }
+            if (!(speed > 0.0))
+            {
+                throw std::invalid_argument("Invalid speed in JournalReplayer");
+            }
+        }
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        JournalReplayer(const JournalReplayer &) = delete;
+        JournalReplayer &operator=(const JournalReplayer &) = delete;
+        JournalReplayer(JournalReplayer &&) = delete;
+        JournalReplayer &operator=(JournalReplayer &&) = delete;
+
+        /**
+         * @brief Replays every committed record from a journal sequence onwards, on the calling thread.
+         *
+         * @param fromSequence First journal sequence to replay (default: 0), e.g. one past a snapshot.
+         * @return The last journal sequence published, or fromSequence - 1 if none.
+         */
+        int64_t replay(int64_t fromSequence = 0)
+        {
+            halted_.store(false, std::memory_order_release);
+            int64_t last = fromSequence - 1;
+            bool started = false;
+
+            const auto segments = listSegments();
+            for (size_t i = 0; i < segments.size(); ++i)
+            {
+                // the next segment's first sequence bounds this one without mapping it
+                if (i + 1 < segments.size() && segments[i + 1].first <= fromSequence)
+                {
+                    continue;
+                }
+
+                JournalSegmentReader<T> segment(segments[i].second);
+                const Record *record = std::lower_bound(
+                    segment.begin(), segment.end(), fromSequence,
+                    [](const Record &r, int64_t sequence)
+                    { return r.sequence < sequence; });
+
+                while (record != segment.end())
+                {
+                    if (halted_.load(std::memory_order_acquire))
+                    {
+                        return last;
+                    }
+                    if (!started)
+                    {
+                        startNs_ = nowNs();
+                        baseNs_ = record->timestampNs;
+                        started = true;
+                    }
+
+                    const int64_t n = claimable(record, segment.end());
+                    const int64_t hi = ringBuffer_.next(n);
+                    const int64_t lo = hi - (n - 1);
+                    for (int64_t sequence = lo; sequence <= hi; ++sequence, ++record)
+                    {
+                        ringBuffer_.get(sequence) = record->event;
+                    }
+                    ringBuffer_.publish(lo, hi);
+                    last = (record - 1)->sequence;
+                }
+            }
+            return last;
+        }
+
+        /**
+         * @brief Stops a running replay after its current batch. Safe to call from any thread.
+         */
+        void halt()
+        {
+            halted_.store(true, std::memory_order_release);
+        }
+
+    private:
+        RingBuffer &ringBuffer_;
+        std::filesystem::path directory_;
+        ReplayPacing pacing_;
+        double speed_;
+        int64_t batchSize_;
+        std::atomic<bool> halted_{false};
+        int64_t startNs_ = 0;
+        int64_t baseNs_ = 0;
+
+        static int64_t nowNs()
+        {
+            return TscClock::nowNs();
+        }
+
+        std::vector<std::pair<int64_t, std::filesystem::path>> listSegments() const
+        {
+            std::vector<std::pair<int64_t, std::filesystem::path>> segments;
+            for (const auto &entry : std::filesystem::directory_iterator(directory_))
+            {
+                const std::string name = entry.path().filename().string();
+                if (name.starts_with("journal-") && name.ends_with(".seg"))
+                {
+                    segments.emplace_back(std::stoll(name.substr(8, name.size() - 12)), entry.path());
+                }
+            }
+            std::sort(segments.begin(), segments.end());
+            return segments;
+        }
+
+        int64_t dueNs(const Record &record) const
+        {
+            return startNs_ + static_cast<int64_t>(static_cast<double>(record.timestampNs - baseNs_) / speed_);
+        }
+
+        /**
+         * @brief Counts the records to publish in the next batch, waiting for the first one to fall due.
+         */
+        int64_t claimable(const Record *record, const Record *end)
+        {
+            const int64_t available = std::min<int64_t>(batchSize_, end - record);
+            if (pacing_ == ReplayPacing::AS_FAST_AS_POSSIBLE)
+            {
+                return available;
+            }
+
+            const int64_t due = dueNs(*record);
+            int64_t now = nowNs();
+            while (now < due && !halted_.load(std::memory_order_relaxed))
+            {
+                if (due - now > 100'000)
+                {
+                    std::this_thread::sleep_for(std::chrono::nanoseconds(due - now - 50'000));
+                }
+                else
+                {
+                    cpu_relax();
+                }
+                now = nowNs();
+            }
+
+            int64_t n = 1;
+            while (n < available && dueNs(record[n]) <= now)
+            {
+                ++n;
+            }
+            return n;
+        }
+    };
+
+} // namespace disruptor
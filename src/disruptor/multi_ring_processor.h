@@ -0,0 +1,286 @@
+/**
+ * @file multi_ring_processor.h
+ * @brief Defines RingSource and MultiRingProcessor for consuming several ring buffers on one thread.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
+#include "event_processor.h"
+#include "exception_handler.h"
+#include "sequence.h"
+#include "sequence_barrier.h"
+#include "wait_strategies.h"
+
+namespace disruptor
+{
+
+    /**
+     * @brief One (barrier, ring, handler) input of a multiplexed processor.
+     *
+     * Unlike EventProcessor it never blocks: poll() processes whatever is available, up to a limit,
+     * and returns. Owns the consumer Sequence to register as a gating sequence.
+     *
+     * @tparam T The type of event.
+     * @tparam DataProvider The type providing access to events (e.g., RingBuffer).
+     * @tparam SequenceBarrier The type of barrier used for checking sequences.
+     * @tparam EventHandler The type of handler for processing events.
+     * @tparam ExceptionHandlerType The type of exception handler (default: DefaultExceptionHandler).
+     */
+    template <typename T, typename DataProvider, typename SequenceBarrier, typename EventHandler,
+              typename ExceptionHandlerType = DefaultExceptionHandler<T>>
+    class RingSource
+    {
+    public:
+        /**
+         * @brief Constructs a RingSource.
+         *
+         * @param dataProvider Reference to the data provider (e.g., ring buffer).
+         * @param sequenceBarrier Reference to the sequence barrier.
+         * @param eventHandler Reference to the event handler.
+         * @param exceptionHandler Reference to the exception handler.
+         */
+        RingSource(
+            DataProvider &dataProvider,
+            SequenceBarrier &sequenceBarrier,
+            EventHandler &eventHandler,
+            ExceptionHandlerType &exceptionHandler)
+            : dataProvider_(dataProvider),
+              sequenceBarrier_(sequenceBarrier),
+              eventHandler_(eventHandler),
+              exceptionHandler_(exceptionHandler),
+              sequence_(-1)
+        {
+            eventHandler_.setSequenceCallback(sequence_);
+        }
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        RingSource(const RingSource &) = delete;
+        RingSource &operator=(const RingSource &) = delete;
+        RingSource(RingSource &&) = delete;
+        RingSource &operator=(RingSource &&) = delete;
+
+        /**
+         * @brief Processes up to limit available events without waiting.
+         *
+         * @param limit Maximum number of events to process.
+         * @return The number of sequences consumed.
+         */
+        int64_t poll(int64_t limit)
+        {
+            int64_t nextSequence = sequence_.get() + 1;
+            const int64_t availableSequence = sequenceBarrier_.peek(nextSequence);
+            if (availableSequence < nextSequence)
+            {
+                return 0;
+            }
+
+            const int64_t firstSequence = nextSequence;
+            const int64_t endOfBatch = std::min(nextSequence + limit - 1, availableSequence);
+            try
+            {
+                eventHandler_.onBatchStart(endOfBatch - nextSequence + 1, availableSequence - nextSequence + 1);
+                while (nextSequence <= endOfBatch)
+                {
+                    auto &&event = dataProvider_.get(nextSequence);
+                    eventHandler_.onEvent(event, nextSequence, nextSequence == endOfBatch);
+                    ++nextSequence;
+                }
+                sequence_.set(endOfBatch);
+            }
+            catch (const std::exception &ex)
+            {
+                auto &&event = dataProvider_.get(nextSequence);
+                exceptionHandler_.handleEventException(ex, nextSequence, event);
+                sequence_.set(nextSequence);
+                ++nextSequence;
+            }
+            return nextSequence - firstSequence;
+        }
+
+        /**
+         * @brief Notifies the event handler that processing has started.
+         */
+        void notifyStart()
+        {
+            try
+            {
+                eventHandler_.onStart();
+            }
+            catch (const std::exception &ex)
+            {
+                exceptionHandler_.handleOnStartException(ex);
+            }
+        }
+
+        /**
+         * @brief Notifies the event handler that processing is shutting down.
+         */
+        void notifyShutdown()
+        {
+            try
+            {
+                eventHandler_.onShutdown();
+            }
+            catch (const std::exception &ex)
+            {
+                exceptionHandler_.handleOnShutdownException(ex);
+            }
+        }
+
+        /**
+         * @brief Gets the sequence tracker for this source.
+         *
+         * @return Reference to the sequence object.
+         */
+        Sequence &getSequence()
+        {
+            return sequence_;
+        }
+
+    private:
+        DataProvider &dataProvider_;
+        SequenceBarrier &sequenceBarrier_;
+        EventHandler &eventHandler_;
+        ExceptionHandlerType &exceptionHandler_;
+        Sequence sequence_;
+    };
+
+    /**
+     * @brief Order in which a MultiRingProcessor polls its sources.
+     */
+    enum class PollPolicy
+    {
+        ROUND_ROBIN = 0, // every source gets up to batchLimit events per round
+        PRIORITY = 1,    // sources in declaration order, restarting from the first after any work
+    };
+
+    /**
+     * @brief Processor consuming several ring buffers on a single thread.
+     *
+     * Each source is checked with a non-blocking barrier peek, so low-rate rings cost one cursor
+     * read per round. The batch limit bounds how long one hot ring can hold the thread. With
+     * PollPolicy::PRIORITY a continuously busy source still starves the ones after it.
+     *
+     * @tparam Sources RingSource types.
+     */
+    template <typename... Sources>
+    class MultiRingProcessor
+    {
+        static_assert(sizeof...(Sources) > 0, "MultiRingProcessor needs at least one source");
+
+    public:
+        /**
+         * @brief Constructs a MultiRingProcessor.
+         *
+         * @param policy The polling policy.
+         * @param batchLimit Maximum events taken from one source per poll.
+         * @param sources The sources, in priority order.
+         */
+        MultiRingProcessor(PollPolicy policy, int64_t batchLimit, Sources &...sources)
+            : sources_(sources...),
+              policy_(policy),
+              batchLimit_(batchLimit),
+              running_(IDLE)
+        {
+            if (batchLimit < 1)
+            {
+                throw std::invalid_argument("Invalid batchLimit in MultiRingProcessor");
+            }
+        }
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        MultiRingProcessor(const MultiRingProcessor &) = delete;
+        MultiRingProcessor &operator=(const MultiRingProcessor &) = delete;
+        MultiRingProcessor(MultiRingProcessor &&) = delete;
+        MultiRingProcessor &operator=(MultiRingProcessor &&) = delete;
+
+        /**
+         * @brief Runs the polling loop on the calling thread until halt().
+         */
+        void run()
+        {
+            ProcessorState expected = IDLE;
+            if (!running_.compare_exchange_strong(expected, RUNNING))
+            {
+                throw std::runtime_error("MultiRingProcessor already running");
+            }
+            std::apply([](auto &...source)
+                       { (source.notifyStart(), ...); }, sources_);
+
+            try
+            {
+                while (running_.load(std::memory_order_acquire) == RUNNING)
+                {
+                    const int64_t processed = policy_ == PollPolicy::PRIORITY ? pollPriority() : pollRoundRobin();
+                    if (processed == 0)
+                    {
+                        cpu_relax();
+                    }
+                }
+            }
+            catch (...)
+            {
+                notifyShutdown();
+                running_.store(IDLE, std::memory_order_release);
+                throw;
+            }
+
+            notifyShutdown();
+            running_.store(IDLE, std::memory_order_release);
+        }
+
+        /**
+         * @brief Halts the processor after the current round.
+         */
+        void halt()
+        {
+            running_.store(HALTED, std::memory_order_release);
+        }
+
+        /**
+         * @brief Checks if the processor is running.
+         *
+         * @return True if the processor is not IDLE, false otherwise.
+         */
+        bool isRunning()
+        {
+            return running_.load(std::memory_order_acquire) != IDLE;
+        }
+
+    private:
+        std::tuple<Sources &...> sources_;
+        PollPolicy policy_;
+        int64_t batchLimit_;
+        std::atomic<ProcessorState> running_;
+
+        int64_t pollRoundRobin()
+        {
+            return std::apply([this](auto &...source)
+                              { return (source.poll(batchLimit_) + ...); }, sources_);
+        }
+
+        int64_t pollPriority()
+        {
+            int64_t processed = 0;
+            std::apply([this, &processed](auto &...source)
+                       { (((processed = source.poll(batchLimit_)) > 0) || ...); }, sources_);
+            return processed;
+        }
+
+        void notifyShutdown()
+        {
+            std::apply([](auto &...source)
+                       { (source.notifyShutdown(), ...); }, sources_);
+        }
+    };
+
+} // namespace disruptor
@@ -0,0 +1,170 @@
+/**
+ * @file overflow_publisher.h
+ * @brief Defines configurable backpressure policies for publishing into a RingBuffer.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+namespace disruptor
+{
+
+    /**
+     * @brief What an OverflowPublisher does when the ring is full.
+     */
+    enum class OverflowPolicy
+    {
+        BLOCK = 0,            // wait for consumers (RingBuffer::next())
+        DROP_NEWEST = 1,      // drop the event being published and count it
+        OVERWRITE_OLDEST = 2, // claim regardless of consumers, overwriting unread slots
+        SAMPLE = 3,           // once full, offer only one in every sampleRate events until one fits, never waiting
+    };
+
+    /**
+     * @brief Publishes events into a RingBuffer under an OverflowPolicy.
+     *
+     * Lets low-priority paths shed load instead of backing up their producer. With OVERWRITE_OLDEST,
+     * a consumer more than N events behind reads slots that have since been reused (possibly while
+     * being written), so events should carry their own sequence for the consumer to check after
+     * reading; this policy requires a sequencer with nextOverwriting(), i.e. a single producer.
+     * SAMPLE publishes everything while the ring has room; after a failed claim it sheds sampleRate - 1
+     * of every sampleRate events without touching the ring, and returns to publishing everything once
+     * a sampled event fits. One OverflowPublisher per producer thread.
+     *
+     * @tparam RingBuffer The ring buffer type.
+     */
+    template <typename RingBuffer>
+    class OverflowPublisher
+    {
+    public:
+        /**
+         * @brief Constructs an OverflowPublisher.
+         *
+         * @param ringBuffer The ring to publish into.
+         * @param policy The overflow policy.
+         * @param sampleRate For SAMPLE, while the ring is full, offer one event in every sampleRate (default: 1).
+         */
+        OverflowPublisher(RingBuffer &ringBuffer, OverflowPolicy policy, int64_t sampleRate = 1)
+            : ringBuffer_(ringBuffer),
+              policy_(policy),
+              sampleRate_(sampleRate)
+        {
+            if (sampleRate < 1)
+            {
+                throw std::invalid_argument("Invalid sampleRate in OverflowPublisher");
+            }
+            if constexpr (!requires { ringBuffer.nextOverwriting(); })
+            {
+                if (policy == OverflowPolicy::OVERWRITE_OLDEST)
+                {
+                    throw std::invalid_argument("OVERWRITE_OLDEST requires a sequencer supporting nextOverwriting()");
+                }
+            }
+        }
+
+        /**
+         * @brief Claims a slot according to the policy, fills it and publishes it.
+         *
+         * @tparam Translator Callable invoked as translator(event, sequence) to fill the slot.
+         * @param translator Fills the claimed event.
+         * @return True if the event was published, false if it was dropped.
+         */
+        template <typename Translator>
+        bool publishEvent(Translator &&translator)
+        {
+            int64_t sequence;
+            switch (policy_)
+            {
+            case OverflowPolicy::BLOCK:
+                sequence = ringBuffer_.next();
+                break;
+            case OverflowPolicy::DROP_NEWEST:
+                if (!ringBuffer_.tryNext(sequence))
+                {
+                    increment(dropped_);
+                    return false;
+                }
+                break;
+            case OverflowPolicy::OVERWRITE_OLDEST:
+                if constexpr (requires { ringBuffer_.nextOverwriting(); })
+                {
+                    sequence = ringBuffer_.nextOverwriting();
+                    break;
+                }
+                else
+                {
+                    return false; // rejected by the constructor
+                }
+            case OverflowPolicy::SAMPLE:
+                if (sampling_ && ++offered_ % sampleRate_ != 0)
+                {
+                    increment(sampledOut_);
+                    return false;
+                }
+                if (!ringBuffer_.tryNext(sequence))
+                {
+                    sampling_ = true;
+                    offered_ = 0;
+                    increment(dropped_);
+                    return false;
+                }
+                sampling_ = false;
+                break;
+            default:
+                return false;
+            }
+
+            std::forward<Translator>(translator)(ringBuffer_.get(sequence), sequence);
+            ringBuffer_.publish(sequence);
+            return true;
+        }
+
+        /**
+         * @brief Gets the number of events dropped because the ring was full, by DROP_NEWEST or SAMPLE.
+         *
+         * Safe to read from any thread.
+         */
+        uint64_t getDroppedCount() const noexcept
+        {
+            return dropped_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Gets the number of events SAMPLE shed without offering them to the full ring.
+         *
+         * Safe to read from any thread.
+         */
+        uint64_t getSampledOutCount() const noexcept
+        {
+            return sampledOut_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Gets the active policy.
+         */
+        OverflowPolicy getPolicy() const noexcept
+        {
+            return policy_;
+        }
+
+    private:
+        RingBuffer &ringBuffer_;
+        OverflowPolicy policy_;
+        int64_t sampleRate_;
+        int64_t offered_ = 0;  // events offered since SAMPLE found the ring full
+        bool sampling_ = false; // SAMPLE found the ring full and no sampled event has fit since
+        std::atomic<uint64_t> dropped_{0};
+        std::atomic<uint64_t> sampledOut_{0};
+
+        static void increment(std::atomic<uint64_t> &counter) noexcept
+        {
+            // single writer, so a plain load/store avoids a locked increment
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    };
+
+} // namespace disruptor
@@ -0,0 +1,150 @@
+/**
+ * @file priority_lane_processor.h
+ * @brief Defines the PriorityLaneProcessor class, consuming a high-priority and a normal ring on one thread.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stdexcept>
+
+#include "event_processor.h"
+#include "multi_ring_processor.h"
+#include "wait_strategies.h"
+
+namespace disruptor
+{
+
+    /**
+     * @brief Scheduling between the lanes of a PriorityLaneProcessor.
+     */
+    enum class LanePolicy
+    {
+        STRICT = 0,   // the normal lane only runs when the high lane is empty
+        WEIGHTED = 1, // each round takes up to highBatch high events, then up to normalBatch normal events
+    };
+
+    /**
+     * @brief Processor giving one ring priority over another.
+     *
+     * Each lane is a RingSource with its own SequenceBarrier. Under STRICT, an urgent event waits for
+     * at most one normal batch (normalBatch events), however deep the normal backlog. Under WEIGHTED,
+     * the batch sizes set the share of throughput, and the normal lane cannot starve.
+     *
+     * @tparam HighSource RingSource of the high-priority ring.
+     * @tparam NormalSource RingSource of the normal ring.
+     */
+    template <typename HighSource, typename NormalSource>
+    class PriorityLaneProcessor
+    {
+    public:
+        /**
+         * @brief Constructs a PriorityLaneProcessor.
+         *
+         * @param high The high-priority lane.
+         * @param normal The normal lane.
+         * @param policy The lane scheduling policy.
+         * @param highBatch Maximum high-priority events per poll (default: 64).
+         * @param normalBatch Maximum normal events per poll (default: 16).
+         */
+        PriorityLaneProcessor(
+            HighSource &high,
+            NormalSource &normal,
+            LanePolicy policy,
+            int64_t highBatch = 64,
+            int64_t normalBatch = 16)
+            : high_(high),
+              normal_(normal),
+              policy_(policy),
+              highBatch_(highBatch),
+              normalBatch_(normalBatch),
+              running_(IDLE)
+        {
+            if (highBatch < 1 || normalBatch < 1)
+            {
+                throw std::invalid_argument("Invalid batch size in PriorityLaneProcessor");
+            }
+        }
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        PriorityLaneProcessor(const PriorityLaneProcessor &) = delete;
+        PriorityLaneProcessor &operator=(const PriorityLaneProcessor &) = delete;
+        PriorityLaneProcessor(PriorityLaneProcessor &&) = delete;
+        PriorityLaneProcessor &operator=(PriorityLaneProcessor &&) = delete;
+
+        /**
+         * @brief Runs the scheduling loop on the calling thread until halt().
+         */
+        void run()
+        {
+            ProcessorState expected = IDLE;
+            if (!running_.compare_exchange_strong(expected, RUNNING))
+            {
+                throw std::runtime_error("PriorityLaneProcessor already running");
+            }
+            high_.notifyStart();
+            normal_.notifyStart();
+
+            try
+            {
+                while (running_.load(std::memory_order_acquire) == RUNNING)
+                {
+                    const int64_t highProcessed = high_.poll(highBatch_);
+                    if (policy_ == LanePolicy::STRICT && highProcessed > 0)
+                    {
+                        continue;
+                    }
+                    const int64_t normalProcessed = normal_.poll(normalBatch_);
+                    if (highProcessed == 0 && normalProcessed == 0)
+                    {
+                        cpu_relax();
+                    }
+                }
+            }
+            catch (...)
+            {
+                notifyShutdown();
+                running_.store(IDLE, std::memory_order_release);
+                throw;
+            }
+
+            notifyShutdown();
+            running_.store(IDLE, std::memory_order_release);
+        }
+
+        /**
+         * @brief Halts the processor after the current round.
+         */
+        void halt()
+        {
+            running_.store(HALTED, std::memory_order_release);
+        }
+
+        /**
+         * @brief Checks if the processor is running.
+         *
+         * @return True if the processor is not IDLE, false otherwise.
+         */
+        bool isRunning()
+        {
+            return running_.load(std::memory_order_acquire) != IDLE;
+        }
+
+    private:
+        HighSource &high_;
+        NormalSource &normal_;
+        LanePolicy policy_;
+        int64_t highBatch_;
+        int64_t normalBatch_;
+        std::atomic<ProcessorState> running_;
+
+        void notifyShutdown()
+        {
+            high_.notifyShutdown();
+            normal_.notifyShutdown();
+        }
+    };
+
+} // namespace disruptor
@@ -0,0 +1,440 @@
+/**
+ * @file replication.h
+ * @brief Defines hot-standby replication over datagram sockets: the ReplicatorHandler and the ReplicaReceiver.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include <sys/socket.h>
+#include <sys/types.h>
+
+#include "event_handler.h"
+#include "event_processor.h"
+#include "wait_strategies.h"
+
+namespace disruptor
+{
+
+    constexpr uint32_t kReplicationMagic = 0x44525031; // "DRP1"
+
+    /**
+     * @brief Kinds of replication datagram.
+     */
+    enum class ReplicationMessage : uint16_t
+    {
+        DATA = 0,      // count events starting at sequence
+        NAK = 1,       // resend sequence..last
+        HEARTBEAT = 2, // the next sequence the primary will send is sequence
+    };
+
+    /**
+     * @brief Header of every replication datagram.
+     */
+    struct ReplicationHeader
+    {
+        uint32_t magic;
+        ReplicationMessage type;
+        uint16_t count;
+        int64_t sequence;
+        int64_t last;
+    };
+
+    /**
+     * @brief Datagram layout shared by both ends.
+     *
+     * @tparam T The event type.
+     * @tparam DatagramBytes Maximum datagram size; the default fits an Ethernet MTU over UDP/IPv4.
+     */
+    template <typename T, size_t DatagramBytes>
+    struct ReplicationDatagram
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Replicated events must be trivially copyable");
+
+        static constexpr size_t kMaxEvents = (DatagramBytes - sizeof(ReplicationHeader)) / sizeof(T);
+        static_assert(kMaxEvents > 0, "Event does not fit in a replication datagram");
+
+        ReplicationHeader header;
+        T events[kMaxEvents];
+
+        static size_t sizeFor(size_t count)
+        {
+            return sizeof(ReplicationHeader) + count * sizeof(T);
+        }
+    };
+
+    /**
+     * @brief Event handler sending every event to a standby over a connected datagram socket.
+     *
+     * Events are packed into datagrams flushed when full or at endOfBatch, so a busy primary sends
+     * few large datagrams. The last HistorySize events are kept to answer NAKs, which are read
+     * from the same socket at each flush. A send that would block is dropped and left to the NAK
+     * path. Since the processor is blocked in its barrier while the ring is idle, another thread
+     * should call tick() periodically (e.g. every millisecond): it answers NAKs and sends a
+     * heartbeat so the standby can detect loss at the tail of a burst. Works over a Unix-domain or
+     * UDP socket; the fd is not owned.
+     *
+     * @tparam T The event type, must be trivially copyable.
+     * @tparam HistorySize Number of events kept for retransmission, a power of 2 (default: 65536).
+     * @tparam DatagramBytes Maximum datagram size (default: 1472).
+     */
+    template <typename T, size_t HistorySize = 65536, size_t DatagramBytes = 1472>
+    class ReplicatorHandler : public EventHandler<T>
+    {
+        static_assert(HistorySize > 0 && (HistorySize & (HistorySize - 1)) == 0, "HistorySize must be a power of 2");
+
+        using Datagram = ReplicationDatagram<T, DatagramBytes>;
+
+    public:
+        /**
+         * @brief Constructs a ReplicatorHandler.
+         *
+         * @param fd A connected datagram socket.
+         */
+        explicit ReplicatorHandler(int fd) : fd_(fd) {}
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        ReplicatorHandler(const ReplicatorHandler &) = delete;
+        ReplicatorHandler &operator=(const ReplicatorHandler &) = delete;
+        ReplicatorHandler(ReplicatorHandler &&) = delete;
+        ReplicatorHandler &operator=(ReplicatorHandler &&) = delete;
+
+        void onEvent(T &event, int64_t sequence, bool endOfBatch) override
+        {
+            if (pendingCount_ == 0)
+            {
+                pendingFirst_ = sequence;
+            }
+            pending_.events[pendingCount_++] = event;
+
+            if (pendingCount_ == Datagram::kMaxEvents || endOfBatch)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                flush();
+                serviceNaks();
+            }
+        }
+
+        void onTimeout(int64_t sequence) override
+        {
+            tick();
+        }
+
+        /**
+         * @brief Answers pending NAKs and sends a heartbeat. Safe to call from any thread.
+         */
+        void tick()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ReplicationHeader heartbeat{kReplicationMagic, ReplicationMessage::HEARTBEAT, 0, nextSequence_, nextSequence_ - 1};
+            send(&heartbeat, sizeof(heartbeat));
+            serviceNaks();
+        }
+
+        /**
+         * @brief Gets the number of retransmitted events.
+         */
+        uint64_t getRetransmitCount() const noexcept
+        {
+            return retransmitted_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        int fd_;
+        Datagram pending_{};
+        size_t pendingCount_ = 0;
+        int64_t pendingFirst_ = 0;
+
+        // guarded by mutex_, taken once per datagram rather than per event
+        std::mutex mutex_;
+        std::array<T, HistorySize> history_{};
+        int64_t nextSequence_ = 0;
+        std::atomic<uint64_t> retransmitted_{0};
+
+        void flush()
+        {
+            for (size_t i = 0; i < pendingCount_; ++i)
+            {
+                history_[static_cast<size_t>(pendingFirst_ + static_cast<int64_t>(i)) & (HistorySize - 1)] = pending_.events[i];
+            }
+            nextSequence_ = pendingFirst_ + static_cast<int64_t>(pendingCount_);
+            pending_.header = {kReplicationMagic, ReplicationMessage::DATA, static_cast<uint16_t>(pendingCount_),
+                               pendingFirst_, nextSequence_ - 1};
+            send(&pending_, Datagram::sizeFor(pendingCount_));
+            pendingCount_ = 0;
+        }
+
+        void send(const void *data, size_t size)
+        {
+            if (::send(fd_, data, size, MSG_DONTWAIT) < 0 &&
+                errno != EAGAIN && errno != EWOULDBLOCK && errno != ENOBUFS && errno != ECONNREFUSED)
+            {
+                throw std::system_error(errno, std::generic_category(), "send replication datagram");
+            }
+        }
+
+        void serviceNaks()
+        {
+            // coalesce every queued NAK, so repeated requests for one gap cost a single resend
+            int64_t first = INT64_MAX;
+            int64_t last = -1;
+            ReplicationHeader nak;
+            while (::recv(fd_, &nak, sizeof(nak), MSG_DONTWAIT) == static_cast<ssize_t>(sizeof(nak)))
+            {
+                if (nak.magic == kReplicationMagic && nak.type == ReplicationMessage::NAK)
+                {
+                    first = std::min(first, nak.sequence);
+                    last = std::max(last, nak.last);
+                }
+            }
+
+            // only what is still in history; an older gap needs a snapshot
+            first = std::max(first, std::max<int64_t>(0, nextSequence_ - static_cast<int64_t>(HistorySize)));
+            last = std::min(last, nextSequence_ - 1);
+            while (first <= last)
+            {
+                const int64_t count = std::min<int64_t>(Datagram::kMaxEvents, last - first + 1);
+                Datagram resend;
+                resend.header = {kReplicationMagic, ReplicationMessage::DATA, static_cast<uint16_t>(count), first, first + count - 1};
+                for (int64_t i = 0; i < count; ++i)
+                {
+                    resend.events[i] = history_[static_cast<size_t>(first + i) & (HistorySize - 1)];
+                }
+                send(&resend, Datagram::sizeFor(static_cast<size_t>(count)));
+                retransmitted_.store(retransmitted_.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+                first += count;
+            }
+        }
+    };
+
+    /**
+     * @brief Receiver republishing replicated events into the standby's ring.
+     *
+     * Events are published strictly in sequence order. A datagram past the expected sequence is a
+     * gap: it is discarded and a NAK is sent for the events up to its last one not yet requested;
+     * the whole missing range is requested again after nakRetryNs while the gap persists. Duplicates are ignored. With a fresh standby ring, ring
+     * sequences match the primary's.
+     *
+     * @tparam RingBuffer The standby ring buffer type.
+     * @tparam T The event type.
+     * @tparam DatagramBytes Maximum datagram size (default: 1472).
+     */
+    template <typename RingBuffer, typename T, size_t DatagramBytes = 1472>
+    class ReplicaReceiver
+    {
+        using Datagram = ReplicationDatagram<T, DatagramBytes>;
+
+    public:
+        /**
+         * @brief Constructs a ReplicaReceiver.
+         *
+         * @param ringBuffer The standby ring.
+         * @param fd A connected datagram socket to the primary; not owned.
+         * @param expectedSequence First sequence to receive (default: 0).
+         * @param nakRetryNs Delay before repeating an unanswered NAK (default: 1ms).
+         * @param nakWindow Maximum events requested past the expected sequence, so that recovering a
+         *                  long gap does not overflow the socket buffers (default: 4096).
+         */
+        ReplicaReceiver(
+            RingBuffer &ringBuffer,
+            int fd,
+            int64_t expectedSequence = 0,
+            int64_t nakRetryNs = 1'000'000,
+            int64_t nakWindow = 4096)
+            : ringBuffer_(ringBuffer),
+              fd_(fd),
+              expected_(expectedSequence),
+              nakRetryNs_(nakRetryNs),
+              nakWindow_(nakWindow),
+              running_(IDLE)
+        {
+            if (nakWindow < 1)
+            {
+                throw std::invalid_argument("Invalid nakWindow in ReplicaReceiver");
+            }
+        }
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        ReplicaReceiver(const ReplicaReceiver &) = delete;
+        ReplicaReceiver &operator=(const ReplicaReceiver &) = delete;
+        ReplicaReceiver(ReplicaReceiver &&) = delete;
+        ReplicaReceiver &operator=(ReplicaReceiver &&) = delete;
+
+        /**
+         * @brief Handles every datagram already queued on the socket, without blocking.
+         *
+         * @return The number of events published.
+         */
+        int64_t poll()
+        {
+            int64_t published = 0;
+            while (true)
+            {
+                const ssize_t size = ::recv(fd_, &datagram_, sizeof(datagram_), MSG_DONTWAIT);
+                if (size < 0)
+                {
+                    // a refused connected socket (primary restarting or not yet bound) reports once and recovers
+                    if (errno == EINTR || errno == ECONNREFUSED)
+                    {
+                        continue;
+                    }
+                    if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    {
+                        break;
+                    }
+                    throw std::system_error(errno, std::generic_category(), "recv replication datagram");
+                }
+                if (size < static_cast<ssize_t>(sizeof(ReplicationHeader)) || datagram_.header.magic != kReplicationMagic)
+                {
+                    continue;
+                }
+                if (datagram_.header.type == ReplicationMessage::DATA &&
+                    size == static_cast<ssize_t>(Datagram::sizeFor(datagram_.header.count)))
+                {
+                    published += onData();
+                }
+                else if (datagram_.header.type == ReplicationMessage::HEARTBEAT && datagram_.header.sequence > expected_)
+                {
+                    requestResend(datagram_.header.sequence - 1);
+                }
+            }
+            return published;
+        }
+
+        /**
+         * @brief Polls on the calling thread until halt().
+         */
+        void run()
+        {
+            ProcessorState expected = IDLE;
+            if (!running_.compare_exchange_strong(expected, RUNNING))
+            {
+                throw std::runtime_error("ReplicaReceiver already running");
+            }
+            try
+            {
+                while (running_.load(std::memory_order_acquire) == RUNNING)
+                {
+                    if (poll() == 0)
+                    {
+                        cpu_relax();
+                    }
+                }
+            }
+            catch (...)
+            {
+                running_.store(IDLE, std::memory_order_release);
+                throw;
+            }
+            running_.store(IDLE, std::memory_order_release);
+        }
+
+        /**
+         * @brief Halts run() after its current poll.
+         */
+        void halt()
+        {
+            running_.store(HALTED, std::memory_order_release);
+        }
+
+        /**
+         * @brief Gets the next sequence expected from the primary.
+         */
+        int64_t getExpectedSequence() const noexcept
+        {
+            return expected_;
+        }
+
+        /**
+         * @brief Gets the number of NAKs sent.
+         */
+        uint64_t getNakCount() const noexcept
+        {
+            return naks_;
+        }
+
+    private:
+        RingBuffer &ringBuffer_;
+        int fd_;
+        int64_t expected_;
+        int64_t nakRetryNs_;
+        int64_t nakWindow_;
+        std::atomic<ProcessorState> running_;
+        Datagram datagram_{};
+        int64_t nakedUpTo_ = -1;
+        int64_t lastNakNs_ = 0;
+        uint64_t naks_ = 0;
+
+        int64_t onData()
+        {
+            const int64_t first = datagram_.header.sequence;
+            const int64_t last = first + datagram_.header.count - 1;
+            if (last < expected_)
+            {
+                return 0; // duplicate
+            }
+            if (first > expected_)
+            {
+                requestResend(last);
+                return 0;
+            }
+
+            const int64_t n = last - expected_ + 1;
+            // claims never exceed the ring, which may be smaller than a datagram
+            int64_t skip = expected_ - first;
+            for (int64_t remaining = n; remaining > 0;)
+            {
+                const int64_t claim = std::min<int64_t>(remaining, static_cast<int64_t>(RingBuffer::kBufferSize));
+                const int64_t hi = ringBuffer_.next(claim);
+                const int64_t lo = hi - (claim - 1);
+                for (int64_t i = 0; i < claim; ++i)
+                {
+                    ringBuffer_.get(lo + i) = datagram_.events[skip + i];
+                }
+                ringBuffer_.publish(lo, hi);
+                skip += claim;
+                remaining -= claim;
+            }
+            expected_ = last + 1;
+            return n;
+        }
+
+        void requestResend(int64_t last)
+        {
+            const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                    std::chrono::steady_clock::now().time_since_epoch())
+                                    .count();
+            last = std::min(last, expected_ + nakWindow_ - 1);
+            const bool retry = now - lastNakNs_ >= nakRetryNs_;
+            if (last <= nakedUpTo_ && !retry)
+            {
+                return;
+            }
+            // extend the outstanding request rather than asking for the whole gap again
+            const int64_t first = retry ? expected_ : std::max(expected_, nakedUpTo_ + 1);
+            ReplicationHeader nak{kReplicationMagic, ReplicationMessage::NAK, 0, first, std::max(last, nakedUpTo_)};
+            if (::send(fd_, &nak, sizeof(nak), MSG_DONTWAIT) >= 0)
+            {
+                nakedUpTo_ = nak.last;
+                lastNakNs_ = now;
+                ++naks_;
+            }
+        }
+    };
+
+} // namespace disruptor
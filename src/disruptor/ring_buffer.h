@@ -5,10 +5,15 @@
 
 #pragma once
 
-#include <array>
+#include <concepts>
+#include <cstddef>
+#include <new>
+#include <type_traits>
 #include <vector>
 
 #include "sequencer.h"
+#include "slot_arena.h"
+#include "slot_layout.h"
 
 namespace disruptor
 {
@@ -23,23 +28,32 @@ namespace disruptor
      * @tparam N The size of the buffer (must be power of 2).
      * @tparam Sequencer The sequencer type used for managing sequences.
      * @tparam EventFactory Factory for creating initial events.
+     * @tparam Layout Slot layout policy (default: PackedLayout).
      */
     template <
         typename T,
         size_t N,
         SequencerConcept Sequencer,
-        typename EventFactory>
+        typename EventFactory,
+        SlotLayoutConcept Layout = PackedLayout>
     class RingBuffer
     {
         static_assert(
             (N & (N - 1)) == 0,
             "Buffer size must be power of 2");
 
+        using Slot = typename Layout::template Slot<T>;
+
     public:
+        using SequencerType = Sequencer;
+        static constexpr size_t kBufferSize = N;
+
         /**
          * @brief Constructs a RingBuffer.
          *
-         * Initializes the buffer with events created by the factory.
+         * Constructs every slot in place from the factory, so T need not be default-constructible,
+         * copyable or movable as long as the factory returns it by value. A factory invocable with
+         * a size_t receives the storage index of the slot being built.
          *
          * @param sequencer Reference to the sequencer.
          * @param factory The event factory.
@@ -49,21 +63,86 @@ namespace disruptor
             const EventFactory &factory)
             : sequencer_(sequencer)
         {
-            for (size_t i = 0; i < N; ++i)
+            size_t i = 0;
+            try
+            {
+                for (; i < N; ++i)
+                {
+                    constructSlot(i, factory);
+                }
+            }
+            catch (...)
             {
-                buffer_[i] = factory();
+                destroySlots(i);
+                throw;
             }
         }
 
+        /**
+         * @brief Destroys every slot.
+         */
+        ~RingBuffer()
+        {
+            destroySlots(N);
+        }
+
         /**
          * @brief Claims the next n sequences for publication.
          *
+         * Events owning a slot arena have it reset for every claimed slot.
+         *
          * @param n Number of sequences to claim (default 1).
          * @return The last claimed sequence number.
          */
         int64_t next(int64_t n = 1)
         {
-            return sequencer_.next(n);
+            const int64_t sequence = sequencer_.next(n);
+            resetArenas(sequence - n + 1, sequence);
+            return sequence;
+        }
+
+        /**
+         * @brief Claims the next n sequences if the ring has room, without waiting.
+         *
+         * @param sequence Receives the last claimed sequence on success.
+         * @param n Number of sequences to claim (default 1).
+         * @return True if claimed, false if the ring is full.
+         */
+        bool tryNext(int64_t &sequence, int64_t n = 1)
+        {
+            if (!sequencer_.tryNext(sequence, n))
+            {
+                return false;
+            }
+            resetArenas(sequence - n + 1, sequence);
+            return true;
+        }
+
+        /**
+         * @brief Claims the next n sequences, overwriting slots slow consumers have not read yet.
+         *
+         * Only available with sequencers supporting lossy claims (SingleProducerSequencer).
+         *
+         * @param n Number of sequences to claim (default 1).
+         * @return The last claimed sequence number.
+         */
+        int64_t nextOverwriting(int64_t n = 1)
+            requires requires(Sequencer &s) { s.nextOverwriting(n); }
+        {
+            const int64_t sequence = sequencer_.nextOverwriting(n);
+            resetArenas(sequence - n + 1, sequence);
+            return sequence;
+        }
+
+        /**
+         * @brief Checks whether n more sequences can be claimed without waiting.
+         *
+         * @param n Required capacity.
+         * @return True if there is room for n more events.
+         */
+        bool hasAvailableCapacity(int64_t n)
+        {
+            return sequencer_.hasAvailableCapacity(n);
         }
 
         /**
@@ -76,6 +155,17 @@ namespace disruptor
             sequencer_.publish(sequence);
         }
 
+        /**
+         * @brief Publishes a claimed range of sequences in one call.
+         *
+         * @param lo First sequence of the range.
+         * @param hi Last sequence of the range.
+         */
+        void publish(int64_t lo, int64_t hi)
+        {
+            sequencer_.publish(lo, hi);
+        }
+
         /**
          * @brief Gets a reference to the event at the given sequence.
          *
@@ -84,7 +174,7 @@ namespace disruptor
          */
         T &get(int64_t sequence)
         {
-            return buffer_[sequence & (N - 1)];
+            return slot(sequence).value;
         }
 
         /**
@@ -95,7 +185,7 @@ namespace disruptor
          */
         const T &get(int64_t sequence) const
         {
-            return buffer_[sequence & (N - 1)];
+            return slot(sequence).value;
         }
 
         /**
@@ -106,7 +196,7 @@ namespace disruptor
          */
         T *get_ptr(int64_t sequence)
         {
-            return &buffer_[sequence & (N - 1)];
+            return &slot(sequence).value;
         }
 
         /**
@@ -117,7 +207,24 @@ namespace disruptor
          */
         const T *get_ptr(int64_t sequence) const
         {
-            return &buffer_[sequence & (N - 1)];
+            return &slot(sequence).value;
+        }
+
+        /**
+         * @brief Prefetches the slot at the given sequence into cache.
+         *
+         * Issues a read prefetch for every cache line spanned by the slot so that
+         * consumers walking large events do not stall on the first access.
+         *
+         * @param sequence The sequence number.
+         */
+        void prefetch(int64_t sequence) const
+        {
+            const char *address = reinterpret_cast<const char *>(&slot(sequence).value);
+            for (size_t offset = 0; offset < sizeof(T); offset += kSizeOfCacheLine)
+            {
+                __builtin_prefetch(address + offset, 0, 3);
+            }
         }
 
         /**
@@ -130,6 +237,27 @@ namespace disruptor
             sequencer_.setGatingSequences(sequences);
         }
 
+        /**
+         * @brief Adds gating sequences while the producer may be running.
+         *
+         * @param sequences Vector of pointers to gating sequences, started at the current cursor.
+         */
+        void addGatingSequences(const std::vector<Sequence *> &sequences)
+        {
+            sequencer_.addGatingSequences(sequences);
+        }
+
+        /**
+         * @brief Removes a gating sequence while the producer may be running.
+         *
+         * @param sequence The gating sequence to remove.
+         * @return True if the sequence was gating the producer.
+         */
+        bool removeGatingSequence(const Sequence &sequence)
+        {
+            return sequencer_.removeGatingSequence(sequence);
+        }
+
         /**
          * @brief Gets the current cursor position.
          *
@@ -159,8 +287,67 @@ namespace disruptor
         RingBuffer &operator=(RingBuffer &&) = delete;
 
     private:
-        std::array<T, N> buffer_;
+        static constexpr size_t kStorageAlignment =
+            alignof(Slot) > kSizeOfCacheLine ? alignof(Slot) : kSizeOfCacheLine;
+
+        // raw storage, slots are placement-constructed by the constructor
+        alignas(kStorageAlignment) std::byte storage_[sizeof(Slot) * N];
         Sequencer &sequencer_;
+
+        Slot *slotAt(size_t index)
+        {
+            return std::launder(reinterpret_cast<Slot *>(storage_ + index * sizeof(Slot)));
+        }
+
+        const Slot *slotAt(size_t index) const
+        {
+            return std::launder(reinterpret_cast<const Slot *>(storage_ + index * sizeof(Slot)));
+        }
+
+        Slot &slot(int64_t sequence)
+        {
+            return *slotAt(Layout::template index<T, N>(sequence));
+        }
+
+        const Slot &slot(int64_t sequence) const
+        {
+            return *slotAt(Layout::template index<T, N>(sequence));
+        }
+
+        void constructSlot(size_t index, const EventFactory &factory)
+        {
+            void *address = storage_ + index * sizeof(Slot);
+            if constexpr (std::invocable<const EventFactory &, size_t>)
+            {
+                ::new (address) Slot{factory(index)};
+            }
+            else
+            {
+                ::new (address) Slot{factory()};
+            }
+        }
+
+        void resetArenas(int64_t lo, int64_t hi)
+        {
+            if constexpr (ArenaEventConcept<T>)
+            {
+                for (int64_t sequence = lo; sequence <= hi; ++sequence)
+                {
+                    slot(sequence).value.arena().reset();
+                }
+            }
+        }
+
+        void destroySlots(size_t count)
+        {
+            if constexpr (!std::is_trivially_destructible_v<Slot>)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    slotAt(i)->~Slot();
+                }
+            }
+        }
     };
 
 } // namespace disruptor
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include <vector>
 #include <memory>
 
+#include "coroutine_scheduler.h"
 #include "sequence.h"
 #include "sequencer.h"
 #include "wait_strategies.h"
@@ -88,6 +89,40 @@ namespace disruptor
             return sequencer_.getHighestPublishedSequence(sequence, available);
         }
 
+        /**
+         * @brief Non-blocking form of waitFor().
+         *
+         * Does not check the alert status.
+         *
+         * @param sequence The sequence to check.
+         * @return The highest available sequence, below sequence if it is not yet available.
+         */
+        int64_t peek(int64_t sequence) const
+        {
+            int64_t available = getCursor();
+
+            if (available < sequence)
+            {
+                return available;
+            }
+
+            return sequencer_.getHighestPublishedSequence(sequence, available);
+        }
+
+        /**
+         * @brief Awaitable form of waitFor() for coroutines run by a CoroutineScheduler.
+         *
+         * `co_await barrier.next(seq)` suspends until seq is available and yields the highest
+         * available sequence, or throws AlertException if the barrier is alerted.
+         *
+         * @param sequence The sequence to wait for.
+         * @return The awaitable.
+         */
+        SequenceAwaiter<SequenceBarrier> next(int64_t sequence)
+        {
+            return SequenceAwaiter<SequenceBarrier>(*this, sequence);
+        }
+
         /**
          * @brief Gets the current cursor value.
          *
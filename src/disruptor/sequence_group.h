@@ -0,0 +1,167 @@
+/**
+ * @file sequence_group.h
+ * @brief Defines the SequenceGroup class, a set of sequences that can change while the producer runs.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "sequence.h"
+
+namespace disruptor
+{
+
+    /**
+     * @brief A set of sequences supporting lock-free reads and concurrent add/remove.
+     *
+     * Readers load a pointer to an immutable array; writers copy the array, modify the copy and swap
+     * the pointer (RCU-style). The reader fast path is one acquire load more than a plain vector.
+     * Replaced arrays are retired rather than freed, since a reader may still be walking them, and
+     * are released with the group; membership changes are expected to be rare.
+     */
+    class SequenceGroup
+    {
+        using Snapshot = std::vector<Sequence *>;
+
+    public:
+        /**
+         * @brief Constructs an empty SequenceGroup.
+         */
+        SequenceGroup()
+        {
+            publish(Snapshot{});
+        }
+
+        /**
+         * @brief Constructs a SequenceGroup holding the given sequences.
+         *
+         * @param sequences The initial sequences.
+         */
+        explicit SequenceGroup(const std::vector<Sequence *> &sequences)
+        {
+            publish(Snapshot(sequences));
+        }
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        SequenceGroup(const SequenceGroup &) = delete;
+        SequenceGroup &operator=(const SequenceGroup &) = delete;
+        SequenceGroup(SequenceGroup &&) = delete;
+        SequenceGroup &operator=(SequenceGroup &&) = delete;
+
+        /**
+         * @brief Replaces all sequences in the group.
+         *
+         * @param sequences The new sequences.
+         */
+        void set(const std::vector<Sequence *> &sequences)
+        {
+            std::lock_guard<std::mutex> lock(writeMutex_);
+            publish(Snapshot(sequences));
+        }
+
+        /**
+         * @brief Adds sequences to the group, starting them at the current cursor.
+         *
+         * Each sequence is moved to the cursor before it becomes visible, and again afterwards in case
+         * the cursor advanced in between, so it never gates the producer on already published slots.
+         * Add a processor's sequence before starting the processor.
+         *
+         * @param sequences The sequences to add.
+         * @param cursor The cursor the new sequences start from.
+         */
+        void add(const std::vector<Sequence *> &sequences, const Sequence &cursor)
+        {
+            std::lock_guard<std::mutex> lock(writeMutex_);
+            Snapshot updated(*current_.load(std::memory_order_acquire));
+            int64_t cursorSequence = cursor.get();
+            for (auto *seq : sequences)
+            {
+                seq->set(cursorSequence);
+                updated.push_back(seq);
+            }
+            publish(std::move(updated));
+
+            cursorSequence = cursor.get();
+            for (auto *seq : sequences)
+            {
+                seq->set(cursorSequence);
+            }
+        }
+
+        /**
+         * @brief Removes a sequence from the group.
+         *
+         * @param sequence The sequence to remove.
+         * @return True if the sequence was a member.
+         */
+        bool remove(const Sequence &sequence)
+        {
+            std::lock_guard<std::mutex> lock(writeMutex_);
+            Snapshot updated(*current_.load(std::memory_order_acquire));
+            auto it = std::remove(updated.begin(), updated.end(), &sequence);
+            if (it == updated.end())
+            {
+                return false;
+            }
+            updated.erase(it, updated.end());
+            publish(std::move(updated));
+            return true;
+        }
+
+        /**
+         * @brief Gets the current members.
+         *
+         * The returned view stays valid for the lifetime of the group.
+         *
+         * @return The sequences at the time of the call.
+         */
+        std::span<Sequence *const> get() const noexcept
+        {
+            return *current_.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Gets the minimum of the member sequences.
+         *
+         * @param minimum Initial minimum (default max int64).
+         * @return The minimum sequence.
+         */
+        int64_t minimum(int64_t minimum = std::numeric_limits<int64_t>::max()) const noexcept
+        {
+            for (const auto *seq : get())
+            {
+                minimum = std::min(minimum, seq->get());
+            }
+            return minimum;
+        }
+
+        /**
+         * @brief Gets the number of members.
+         */
+        size_t size() const noexcept
+        {
+            return get().size();
+        }
+
+    private:
+        std::atomic<const Snapshot *> current_{nullptr};
+        std::mutex writeMutex_;
+        std::vector<std::unique_ptr<const Snapshot>> snapshots_; // every array ever published
+
+        void publish(Snapshot &&snapshot)
+        {
+            snapshots_.push_back(std::make_unique<const Snapshot>(std::move(snapshot)));
+            current_.store(snapshots_.back().get(), std::memory_order_release);
+        }
+    };
+
+} // namespace disruptor
@@ -0,0 +1,252 @@
+/**
+ * @file sequence_watchdog.h
+ * @brief Defines the SequenceWatchdog, a background monitor of consumer lag and stalls.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sequence.h"
+#include "tsc_clock.h"
+
+namespace disruptor
+{
+
+    /**
+     * @brief State of one watched consumer at a sample.
+     */
+    struct WatchdogSample
+    {
+        std::string name;
+        int64_t cursor;
+        int64_t sequence;
+        int64_t lag;           // cursor - sequence
+        double eventsPerSecond; // since the previous sample
+        int64_t stalledNs;      // time the sequence has not moved while lagging, 0 if moving
+    };
+
+    /**
+     * @brief Thread sampling a ring's cursor and consumer sequences to detect lagging and stalled consumers.
+     *
+     * Sequences are only read, with the same acquire loads barriers use, so the hot path pays nothing.
+     * A lag callback fires when a consumer's lag first exceeds its threshold, and a stall callback when
+     * its sequence has not moved for the stall time while events are pending; each fires once per episode
+     * and re-arms when the condition clears. Callbacks run on the watchdog thread.
+     *
+     * @tparam CursorSource Type providing getCursor() (e.g., RingBuffer).
+     */
+    template <typename CursorSource>
+    class SequenceWatchdog
+    {
+    public:
+        using Callback = std::function<void(const WatchdogSample &)>;
+
+        /**
+         * @brief Constructs a SequenceWatchdog.
+         *
+         * @param source The ring whose cursor is sampled.
+         * @param period Sampling period.
+         * @param stall Time a lagging sequence may stay still before it counts as stalled.
+         */
+        SequenceWatchdog(const CursorSource &source, std::chrono::nanoseconds period, std::chrono::nanoseconds stall)
+            : source_(source),
+              period_(period),
+              stallNs_(stall.count())
+        {
+            if (period.count() <= 0 || stall.count() <= 0)
+            {
+                throw std::invalid_argument("Invalid period or stall in SequenceWatchdog");
+            }
+        }
+
+        ~SequenceWatchdog()
+        {
+            stop();
+        }
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        SequenceWatchdog(const SequenceWatchdog &) = delete;
+        SequenceWatchdog &operator=(const SequenceWatchdog &) = delete;
+        SequenceWatchdog(SequenceWatchdog &&) = delete;
+        SequenceWatchdog &operator=(SequenceWatchdog &&) = delete;
+
+        /**
+         * @brief Registers a consumer sequence. Only before start().
+         *
+         * @param name Name reported in samples.
+         * @param sequence The consumer's sequence.
+         * @param lagThreshold Lag above which the lag callback fires.
+         */
+        void watch(std::string name, const Sequence &sequence, int64_t lagThreshold)
+        {
+            if (worker_.joinable())
+            {
+                throw std::logic_error("SequenceWatchdog already started");
+            }
+            watched_.push_back({std::move(name), &sequence, lagThreshold});
+        }
+
+        /**
+         * @brief Sets the callback fired when a lag threshold is exceeded. Only before start().
+         */
+        void onLag(Callback callback)
+        {
+            onLag_ = std::move(callback);
+        }
+
+        /**
+         * @brief Sets the callback fired when a lagging sequence stops moving. Only before start().
+         */
+        void onStall(Callback callback)
+        {
+            onStall_ = std::move(callback);
+        }
+
+        /**
+         * @brief Starts sampling on a background thread.
+         */
+        void start()
+        {
+            if (worker_.joinable())
+            {
+                throw std::logic_error("SequenceWatchdog already started");
+            }
+            stopping_ = false;
+            worker_ = std::thread([this]
+                                  { sampleLoop(); });
+        }
+
+        /**
+         * @brief Stops sampling and joins the thread.
+         */
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            condition_.notify_one();
+            if (worker_.joinable())
+            {
+                worker_.join();
+            }
+        }
+
+        /**
+         * @brief Gets the latest sample of every watched consumer.
+         */
+        std::vector<WatchdogSample> getSamples() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return samples_;
+        }
+
+        /**
+         * @brief Takes one sample on the calling thread, firing callbacks.
+         *
+         * For callers driving the watchdog from their own timer instead of start(); never both.
+         */
+        void sample()
+        {
+            const int64_t now = TscClock::nowNs();
+            const int64_t cursor = source_.getCursor();
+            std::vector<WatchdogSample> samples;
+            samples.reserve(watched_.size());
+
+            for (Watched &watched : watched_)
+            {
+                const int64_t sequence = watched.sequence->get();
+                const int64_t lag = cursor - sequence;
+                const double elapsed = static_cast<double>(now - watched.lastSampleNs) * 1e-9;
+                const double rate = watched.lastSampleNs != 0 && elapsed > 0.0
+                                        ? static_cast<double>(sequence - watched.lastSequence) / elapsed
+                                        : 0.0;
+
+                if (sequence != watched.lastSequence || lag <= 0)
+                {
+                    watched.lastMoveNs = now;
+                    watched.stallReported = false;
+                }
+                watched.lastSequence = sequence;
+                watched.lastSampleNs = now;
+
+                WatchdogSample sample{watched.name, cursor, sequence, lag, rate, now - watched.lastMoveNs};
+                if (lag > watched.lagThreshold)
+                {
+                    if (!watched.lagReported && onLag_)
+                    {
+                        onLag_(sample);
+                    }
+                    watched.lagReported = true;
+                }
+                else
+                {
+                    watched.lagReported = false;
+                }
+                if (sample.stalledNs >= stallNs_ && !watched.stallReported)
+                {
+                    if (onStall_)
+                    {
+                        onStall_(sample);
+                    }
+                    watched.stallReported = true;
+                }
+                samples.push_back(std::move(sample));
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            samples_ = std::move(samples);
+        }
+
+    private:
+        struct Watched
+        {
+            std::string name;
+            const Sequence *sequence;
+            int64_t lagThreshold;
+            int64_t lastSequence = -1;
+            int64_t lastSampleNs = 0;
+            int64_t lastMoveNs = TscClock::nowNs();
+            bool lagReported = false;
+            bool stallReported = false;
+        };
+
+        const CursorSource &source_;
+        std::chrono::nanoseconds period_;
+        int64_t stallNs_;
+        std::vector<Watched> watched_;
+        Callback onLag_;
+        Callback onStall_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable condition_;
+        bool stopping_ = false;
+        std::vector<WatchdogSample> samples_;
+        std::thread worker_;
+
+        void sampleLoop()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (!condition_.wait_for(lock, period_, [this]
+                                        { return stopping_; }))
+            {
+                lock.unlock();
+                sample();
+                lock.lock();
+            }
+        }
+    };
+
+} // namespace disruptor
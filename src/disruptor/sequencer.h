@@ -5,7 +5,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <stdexcept>
+
 #include "sequence.h"
+#include "sequence_group.h"
 #include "wait_strategies.h"
 
 namespace disruptor
@@ -45,6 +52,10 @@ namespace disruptor
             "Buffer size must be power of 2");
 
     public:
+        using WaitStrategyType = WaitStrategy;
+        static constexpr size_t kBufferSize = N;
+        static constexpr bool kSingleProducer = true;
+
         /**
          * @brief Constructs a SingleProducerSequencer.
          *
@@ -97,6 +108,70 @@ namespace disruptor
             return nextSeq;
         }
 
+        /**
+         * @brief Claims the next n sequences if the ring has room, without waiting.
+         *
+         * @param sequence Receives the last claimed sequence on success.
+         * @param n Number of sequences to claim (default 1).
+         * @return True if claimed, false if the ring is full.
+         */
+        bool tryNext(int64_t &sequence, int64_t n = 1)
+        {
+            if (n < 1 || n > static_cast<int64_t>(N))
+            {
+                throw std::invalid_argument("Invalid n in tryNext()");
+            }
+            if (!hasAvailableCapacity(n))
+            {
+                return false;
+            }
+            nextValue_ += n;
+            sequence = nextValue_;
+            return true;
+        }
+
+        /**
+         * @brief Claims the next n sequences ignoring the gating sequences.
+         *
+         * For lossy rings: slots still unread by slow consumers are overwritten, and consumers detect
+         * the gap from a sequence carried in the event.
+         *
+         * @param n Number of sequences to claim (default 1).
+         * @return The last claimed sequence.
+         */
+        int64_t nextOverwriting(int64_t n = 1)
+        {
+            if (n < 1 || n > static_cast<int64_t>(N))
+            {
+                throw std::invalid_argument("Invalid n in nextOverwriting()");
+            }
+            nextValue_ += n;
+            return nextValue_;
+        }
+
+        /**
+         * @brief Checks whether n more sequences can be claimed without waiting.
+         *
+         * @param n Required capacity.
+         * @return True if there is room for n more events.
+         */
+        bool hasAvailableCapacity(int64_t n)
+        {
+            int64_t wrapPoint = nextValue_ + n - N;
+            int64_t cachedGating = cachedValue_;
+
+            if (wrapPoint > cachedGating || cachedGating > nextValue_)
+            {
+                int64_t minSeq = getMinimumGatingSequence(nextValue_);
+                cachedValue_ = minSeq;
+                if (wrapPoint > minSeq)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
         /**
          * @brief Publishes a sequence.
          *
@@ -108,6 +183,19 @@ namespace disruptor
             waitStrategy_.signalAllWhenBlocking();
         }
 
+        /**
+         * @brief Publishes a claimed range of sequences.
+         *
+         * With a single producer the cursor covers the whole range, so this is one cursor update.
+         *
+         * @param lo First sequence of the range.
+         * @param hi Last sequence of the range.
+         */
+        void publish(int64_t lo, int64_t hi)
+        {
+            publish(hi);
+        }
+
         /**
          * @brief Gets the cursor sequence.
          *
@@ -125,7 +213,30 @@ namespace disruptor
          */
         void setGatingSequences(const std::vector<Sequence *> &sequences)
         {
-            gatingSequences_ = sequences;
+            gatingSequences_.set(sequences);
+        }
+
+        /**
+         * @brief Adds gating sequences while the producer may be running.
+         *
+         * The new sequences start at the current cursor.
+         *
+         * @param sequences The gating sequences to add.
+         */
+        void addGatingSequences(const std::vector<Sequence *> &sequences)
+        {
+            gatingSequences_.add(sequences, cursor_);
+        }
+
+        /**
+         * @brief Removes a gating sequence while the producer may be running.
+         *
+         * @param sequence The gating sequence to remove.
+         * @return True if the sequence was gating the producer.
+         */
+        bool removeGatingSequence(const Sequence &sequence)
+        {
+            return gatingSequences_.remove(sequence);
         }
 
         /**
@@ -137,13 +248,7 @@ namespace disruptor
         int64_t getMinimumGatingSequence(
             int64_t minimum = std::numeric_limits<int64_t>::max()) const
         {
-            int64_t min = minimum;
-            for (const auto *seq : gatingSequences_)
-            {
-                int64_t seqValue = seq->get();
-                min = std::min(min, seqValue);
-            }
-            return min;
+            return gatingSequences_.minimum(minimum);
         }
 
         /**
@@ -186,7 +291,299 @@ namespace disruptor
         const WaitStrategy &waitStrategy_;
         int64_t nextValue_;   // holds the last sequence number claimed by the producer
         int64_t cachedValue_; // holds the last known minimum consumer sequence, slowest gating sequence
-        std::vector<Sequence *> gatingSequences_;
+        SequenceGroup gatingSequences_;
+    };
+
+    /**
+     * @brief Multi producer sequencer for the disruptor.
+     *
+     * Producers claim sequences by atomically advancing the cursor, so the cursor marks claimed rather
+     * than published slots. Publication is tracked per slot in an availability buffer holding the
+     * lap number (sequence / N) of the last sequence published there; consumers use
+     * getHighestPublishedSequence() to find the contiguous published prefix.
+     *
+     * @tparam N Buffer size (power of 2).
+     * @tparam WaitStrategy The wait strategy.
+     */
+    template <size_t N, typename WaitStrategy>
+    class MultiProducerSequencer
+    {
+        static_assert(
+            (N & (N - 1)) == 0,
+            "Buffer size must be power of 2");
+
+        static constexpr int kIndexShift = std::countr_zero(N);
+
+    public:
+        using WaitStrategyType = WaitStrategy;
+        static constexpr size_t kBufferSize = N;
+        static constexpr bool kSingleProducer = false;
+
+        /**
+         * @brief Constructs a MultiProducerSequencer.
+         *
+         * @param waitStrategy The wait strategy.
+         */
+        explicit MultiProducerSequencer(const WaitStrategy &waitStrategy)
+            : waitStrategy_(waitStrategy)
+        {
+            cursor_.set(-1);
+            gatingSequenceCache_.set(-1);
+            for (auto &flag : availableBuffer_)
+            {
+                flag.store(-1, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        MultiProducerSequencer(const MultiProducerSequencer &) = delete;
+        MultiProducerSequencer &operator=(const MultiProducerSequencer &) = delete;
+        MultiProducerSequencer(MultiProducerSequencer &&) = delete;
+        MultiProducerSequencer &operator=(MultiProducerSequencer &&) = delete;
+
+        /**
+         * @brief Claims the next n sequences.
+         *
+         * @param n Number of sequences to claim (default 1).
+         * @return The last claimed sequence.
+         */
+        int64_t next(int64_t n = 1)
+        {
+            if (n < 1 || n > static_cast<int64_t>(N))
+            {
+                throw std::invalid_argument("Invalid n in next()");
+            }
+
+            int64_t nextSeq = cursor_.incrementAndGet(n);
+            int64_t current = nextSeq - n;
+            int64_t wrapPoint = nextSeq - N;
+            int64_t cachedGating = gatingSequenceCache_.get();
+
+            if (wrapPoint > cachedGating || cachedGating > current)
+            {
+                int64_t minSeq;
+                while (wrapPoint > (minSeq = getMinimumGatingSequence(current)))
+                {
+                    waitStrategy_.producerWait();
+                }
+                gatingSequenceCache_.set(minSeq);
+            }
+
+            return nextSeq;
+        }
+
+        /**
+         * @brief Claims the next n sequences if the ring has room, without waiting.
+         *
+         * @param sequence Receives the last claimed sequence on success.
+         * @param n Number of sequences to claim (default 1).
+         * @return True if claimed, false if the ring is full.
+         */
+        bool tryNext(int64_t &sequence, int64_t n = 1)
+        {
+            if (n < 1 || n > static_cast<int64_t>(N))
+            {
+                throw std::invalid_argument("Invalid n in tryNext()");
+            }
+
+            int64_t current;
+            int64_t nextSeq;
+            do
+            {
+                current = cursor_.get();
+                nextSeq = current + n;
+                if (!hasAvailableCapacity(n, current))
+                {
+                    return false;
+                }
+            } while (!cursor_.compareAndSet(current, nextSeq));
+
+            sequence = nextSeq;
+            return true;
+        }
+
+        /**
+         * @brief Checks whether n more sequences can be claimed without waiting.
+         *
+         * @param n Required capacity.
+         * @return True if there is room for n more events.
+         */
+        bool hasAvailableCapacity(int64_t n)
+        {
+            return hasAvailableCapacity(n, cursor_.get());
+        }
+
+        /**
+         * @brief Publishes a sequence.
+         *
+         * @param sequence The sequence to publish.
+         */
+        void publish(int64_t sequence)
+        {
+            setAvailable(sequence);
+            waitStrategy_.signalAllWhenBlocking();
+        }
+
+        /**
+         * @brief Publishes a claimed range of sequences.
+         *
+         * One release fence orders every event write before the flags, which are then written as
+         * relaxed stores over at most two contiguous runs of the buffer, followed by a single wake-up.
+         *
+         * @param lo First sequence of the range.
+         * @param hi Last sequence of the range.
+         */
+        void publish(int64_t lo, int64_t hi)
+        {
+            std::atomic_thread_fence(std::memory_order_release);
+            for (int64_t sequence = lo; sequence <= hi;)
+            {
+                const size_t index = static_cast<size_t>(sequence) & (N - 1);
+                const int64_t run = std::min<int64_t>(hi - sequence + 1, static_cast<int64_t>(N - index));
+                const int32_t flag = availabilityFlag(sequence);
+                for (int64_t i = 0; i < run; ++i)
+                {
+                    availableBuffer_[index + i].store(flag, std::memory_order_relaxed);
+                }
+                sequence += run;
+            }
+            waitStrategy_.signalAllWhenBlocking();
+        }
+
+        /**
+         * @brief Gets the cursor sequence, the highest claimed sequence.
+         *
+         * @return The cursor value.
+         */
+        int64_t getCursor() const noexcept
+        {
+            return cursor_.get();
+        }
+
+        /**
+         * @brief Sets the gating sequences.
+         *
+         * @param sequences The gating sequences.
+         */
+        void setGatingSequences(const std::vector<Sequence *> &sequences)
+        {
+            gatingSequences_.set(sequences);
+        }
+
+        /**
+         * @brief Adds gating sequences while producers may be running.
+         *
+         * The new sequences start at the current cursor.
+         *
+         * @param sequences The gating sequences to add.
+         */
+        void addGatingSequences(const std::vector<Sequence *> &sequences)
+        {
+            gatingSequences_.add(sequences, cursor_);
+        }
+
+        /**
+         * @brief Removes a gating sequence while producers may be running.
+         *
+         * @param sequence The gating sequence to remove.
+         * @return True if the sequence was gating the producers.
+         */
+        bool removeGatingSequence(const Sequence &sequence)
+        {
+            return gatingSequences_.remove(sequence);
+        }
+
+        /**
+         * @brief Gets the minimum gating sequence.
+         *
+         * @param minimum Initial minimum (default max int64).
+         * @return The minimum sequence.
+         */
+        int64_t getMinimumGatingSequence(
+            int64_t minimum = std::numeric_limits<int64_t>::max()) const
+        {
+            return gatingSequences_.minimum(minimum);
+        }
+
+        /**
+         * @brief Checks if a sequence has been published.
+         *
+         * @param sequence The sequence.
+         * @return True if available.
+         */
+        bool isAvailable(int64_t sequence) const
+        {
+            const size_t index = static_cast<size_t>(sequence) & (N - 1);
+            return availableBuffer_[index].load(std::memory_order_acquire) == availabilityFlag(sequence);
+        }
+
+        /**
+         * @brief Gets the highest published sequence in a range.
+         *
+         * @param lowerBound Lower bound.
+         * @param available Highest claimed sequence.
+         * @return The last sequence of the contiguous published run starting at lowerBound.
+         */
+        int64_t getHighestPublishedSequence(int64_t lowerBound, int64_t available) const
+        {
+            for (int64_t sequence = lowerBound; sequence <= available; ++sequence)
+            {
+                if (!isAvailable(sequence))
+                {
+                    return sequence - 1;
+                }
+            }
+            return available;
+        }
+
+        /**
+         * @brief Creates a new sequence barrier.
+         *
+         * @param dependents Dependent sequences.
+         * @return The sequence barrier.
+         */
+        auto newBarrier(const std::vector<Sequence *> &dependents)
+        {
+            return SequenceBarrier<MultiProducerSequencer<N, WaitStrategy>, WaitStrategy>(
+                *this, waitStrategy_, cursor_, dependents);
+        }
+
+    private:
+        Sequence cursor_;
+        Sequence gatingSequenceCache_; // shared by producers, last known slowest gating sequence
+        const WaitStrategy &waitStrategy_;
+        SequenceGroup gatingSequences_;
+        alignas(kSizeOfCacheLine) std::array<std::atomic<int32_t>, N> availableBuffer_;
+
+        bool hasAvailableCapacity(int64_t n, int64_t current)
+        {
+            int64_t wrapPoint = current + n - N;
+            int64_t cachedGating = gatingSequenceCache_.get();
+
+            if (wrapPoint > cachedGating || cachedGating > current)
+            {
+                int64_t minSeq = getMinimumGatingSequence(current);
+                gatingSequenceCache_.set(minSeq);
+                if (wrapPoint > minSeq)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static int32_t availabilityFlag(int64_t sequence) noexcept
+        {
+            return static_cast<int32_t>(sequence >> kIndexShift);
+        }
+
+        void setAvailable(int64_t sequence)
+        {
+            const size_t index = static_cast<size_t>(sequence) & (N - 1);
+            availableBuffer_[index].store(availabilityFlag(sequence), std::memory_order_release);
+        }
     };
 
 } // namespace disruptor
\ No newline at end of file
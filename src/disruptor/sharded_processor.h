@@ -0,0 +1,270 @@
+/**
+ * @file sharded_processor.h
+ * @brief Defines key-sharded event handling, giving ordered-per-key parallelism across processors.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "event_handler.h"
+#include "event_processor.h"
+#include "exception_handler.h"
+#include "sequence.h"
+
+namespace disruptor
+{
+
+    /**
+     * @brief Handler adapter forwarding only the events whose key maps to one shard.
+     *
+     * Every shard sees every sequence, but non-owned slots cost one key projection and hash. Events
+     * of one key always reach the same shard, so they stay in order. Owned events are delivered as
+     * they arrive, so an exception from the inner handler is reported against its own sequence. To
+     * give the inner handler endOfBatch = true on the last event it owns in the batch, the adapter
+     * looks ahead through the rest of the batch for the next owned slot; the slots it skips are not
+     * projected again. Batch bounds come from onBatchStart(); without it every owned event ends its
+     * own batch. The sequence callback is not forwarded.
+     *
+     * @tparam T The type of event.
+     * @tparam DataProvider The type providing access to events (e.g., RingBuffer).
+     * @tparam Handler The wrapped handler type.
+     * @tparam Projection Callable returning the key of an event.
+     */
+    template <typename T, typename DataProvider, typename Handler, typename Projection>
+    class ShardedEventHandler : public EventHandler<T>
+    {
+    public:
+        /**
+         * @brief Constructs a ShardedEventHandler.
+         *
+         * @param dataProvider The data provider the events come from, read ahead within a batch.
+         * @param handler The handler receiving owned events.
+         * @param projection Callable returning the key of an event.
+         * @param shard Index of this shard.
+         * @param shardCount Total number of shards.
+         */
+        ShardedEventHandler(DataProvider &dataProvider, Handler &handler, Projection projection, size_t shard,
+                            size_t shardCount)
+            : dataProvider_(dataProvider),
+              handler_(handler),
+              projection_(std::move(projection)),
+              shard_(shard),
+              shardCount_(shardCount) {}
+
+        /**
+         * @brief Maps a key to its shard.
+         *
+         * @param key The event key.
+         * @param shardCount Total number of shards.
+         * @return The owning shard index.
+         */
+        template <typename Key>
+        static size_t shardOf(const Key &key, size_t shardCount)
+        {
+            return std::hash<Key>{}(key) % shardCount;
+        }
+
+        void onEvent(T &event, int64_t sequence, bool endOfBatch) override
+        {
+            if (batchEnd_ < sequence)
+            {
+                batchEnd_ = endOfBatch ? sequence : sequence + batchSize_ - 1;
+            }
+            // slots up to scanned_ were already projected by the look-ahead
+            const bool owned = sequence <= scanned_ ? sequence == nextOwned_
+                                                    : shardOf(projection_(event), shardCount_) == shard_;
+            if (owned)
+            {
+                lookAhead(sequence + 1);
+                handler_.onEvent(event, sequence, nextOwned_ < 0);
+            }
+        }
+
+        void onBatchStart(int64_t batchSize, int64_t queueDepth) override
+        {
+            // a batch cut short by an exception is followed by a new one, so nothing carries over
+            batchSize_ = batchSize;
+            batchEnd_ = -1;
+            scanned_ = -1;
+            nextOwned_ = -1;
+            handler_.onBatchStart(batchSize, queueDepth);
+        }
+
+        void onStart() override
+        {
+            handler_.onStart();
+        }
+
+        void onShutdown() override
+        {
+            handler_.onShutdown();
+        }
+
+        void onTimeout(int64_t sequence) override
+        {
+            handler_.onTimeout(sequence);
+        }
+
+    private:
+        DataProvider &dataProvider_;
+        Handler &handler_;
+        Projection projection_;
+        size_t shard_;
+        size_t shardCount_;
+        int64_t batchSize_ = 1;
+        int64_t batchEnd_ = -1;
+        int64_t scanned_ = -1;   // last sequence projected by the look-ahead, never past the batch
+        int64_t nextOwned_ = -1; // owned sequence the look-ahead stopped at, -1 if none
+
+        /**
+         * @brief Scans from a sequence to the end of the batch for the next owned one.
+         *
+         * @param sequence The first sequence to scan.
+         */
+        void lookAhead(int64_t sequence)
+        {
+            nextOwned_ = -1;
+            for (; sequence <= batchEnd_; ++sequence)
+            {
+                auto &&event = dataProvider_.get(sequence);
+                if (shardOf(projection_(event), shardCount_) == shard_)
+                {
+                    nextOwned_ = sequence;
+                    break;
+                }
+            }
+            scanned_ = std::min(sequence, batchEnd_);
+        }
+    };
+
+    /**
+     * @brief K processors on one ring, each owning the keys that hash to it.
+     *
+     * Each shard gets its own barrier over the same dependents, so halting or starting one shard never
+     * alerts or clears the alert of another. Call run(shard) on K threads and halt() to stop them all.
+     * Register getSequences() (or a GatingGroup over them) as gating sequences.
+     *
+     * @tparam T The type of event.
+     * @tparam DataProvider The type providing access to events (e.g., RingBuffer).
+     * @tparam SequenceBarrier The type of barrier used for waiting on sequences.
+     * @tparam Handler The per-shard handler type.
+     * @tparam Projection Callable returning the key of an event.
+     * @tparam K Number of shards.
+     * @tparam ExceptionHandlerType The type of exception handler (default: DefaultExceptionHandler).
+     */
+    template <typename T, typename DataProvider, typename SequenceBarrier, typename Handler, typename Projection,
+              size_t K, typename ExceptionHandlerType = DefaultExceptionHandler<T>>
+    class ShardedProcessorSet
+    {
+        static_assert(K > 0, "ShardedProcessorSet needs at least one shard");
+
+        using ShardHandler = ShardedEventHandler<T, DataProvider, Handler, Projection>;
+        using Processor = EventProcessor<T, DataProvider, SequenceBarrier, ShardHandler, ExceptionHandlerType>;
+
+    public:
+        /**
+         * @brief Constructs a ShardedProcessorSet.
+         *
+         * @param dataProvider Reference to the data provider (e.g., ring buffer).
+         * @param sequencer The sequencer creating each shard's barrier.
+         * @param dependents Sequences every shard waits on (empty to follow the cursor).
+         * @param handlers One handler per shard.
+         * @param projection Callable returning the key of an event.
+         * @param exceptionHandler Reference to the exception handler.
+         * @param batchSize The batch size for processing events (default: 64).
+         */
+        template <typename Sequencer>
+        ShardedProcessorSet(
+            DataProvider &dataProvider,
+            Sequencer &sequencer,
+            const std::vector<Sequence *> &dependents,
+            const std::array<Handler *, K> &handlers,
+            const Projection &projection,
+            ExceptionHandlerType &exceptionHandler,
+            int64_t batchSize = 64)
+            : ShardedProcessorSet(dataProvider, sequencer, dependents, handlers, projection, exceptionHandler,
+                                  batchSize, std::make_index_sequence<K>{}) {}
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        ShardedProcessorSet(const ShardedProcessorSet &) = delete;
+        ShardedProcessorSet &operator=(const ShardedProcessorSet &) = delete;
+        ShardedProcessorSet(ShardedProcessorSet &&) = delete;
+        ShardedProcessorSet &operator=(ShardedProcessorSet &&) = delete;
+
+        /**
+         * @brief Runs one shard's processing loop on the calling thread.
+         *
+         * @param shard The shard index.
+         */
+        void run(size_t shard)
+        {
+            processors_[shard].run();
+        }
+
+        /**
+         * @brief Halts every shard.
+         */
+        void halt()
+        {
+            for (auto &processor : processors_)
+            {
+                processor.halt();
+            }
+        }
+
+        /**
+         * @brief Gets one shard's processor.
+         *
+         * @param shard The shard index.
+         * @return Reference to the processor.
+         */
+        Processor &getProcessor(size_t shard)
+        {
+            return processors_[shard];
+        }
+
+        /**
+         * @brief Gets the sequences of every shard, for gating.
+         *
+         * @return Pointers to the shard sequences.
+         */
+        std::vector<Sequence *> getSequences()
+        {
+            std::vector<Sequence *> sequences;
+            for (auto &processor : processors_)
+            {
+                sequences.push_back(&processor.getSequence());
+            }
+            return sequences;
+        }
+
+    private:
+        std::array<SequenceBarrier, K> barriers_;
+        std::array<ShardHandler, K> shards_;
+        std::array<Processor, K> processors_;
+
+        template <typename Sequencer, size_t... I>
+        ShardedProcessorSet(
+            DataProvider &dataProvider,
+            Sequencer &sequencer,
+            const std::vector<Sequence *> &dependents,
+            const std::array<Handler *, K> &handlers,
+            const Projection &projection,
+            ExceptionHandlerType &exceptionHandler,
+            int64_t batchSize,
+            std::index_sequence<I...>)
+            : barriers_{((void)I, sequencer.newBarrier(dependents))...},
+              shards_{ShardHandler(dataProvider, *handlers[I], projection, I, K)...},
+              processors_{Processor(dataProvider, barriers_[I], shards_[I], exceptionHandler, batchSize)...} {}
+    };
+
+} // namespace disruptor
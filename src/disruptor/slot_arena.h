@@ -0,0 +1,349 @@
+/**
+ * @file slot_arena.h
+ * @brief Defines per-slot bump arenas and arena-backed string/vector types for events with dynamic payloads.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string_view>
+#include <type_traits>
+
+namespace disruptor
+{
+
+    /**
+     * @brief Fixed-size bump allocator embedded in an event slot.
+     *
+     * Allocation is a pointer bump; nothing is freed individually. RingBuffer::next() resets the
+     * arena of every slot it reclaims, so payload memory is bounded by N x Bytes and publishing
+     * never touches the heap. Not copyable or movable, since payloads point into it.
+     *
+     * @tparam Bytes Capacity of the arena in bytes.
+     */
+    template <size_t Bytes>
+    class SlotArena
+    {
+    public:
+        SlotArena() noexcept = default;
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        SlotArena(const SlotArena &) = delete;
+        SlotArena &operator=(const SlotArena &) = delete;
+        SlotArena(SlotArena &&) = delete;
+        SlotArena &operator=(SlotArena &&) = delete;
+
+        /**
+         * @brief Allocates raw memory from the arena.
+         *
+         * @param size Number of bytes.
+         * @param alignment Required alignment (power of 2).
+         * @return Pointer to the allocated memory.
+         * @throws std::bad_alloc if the arena is exhausted.
+         */
+        void *allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+        {
+            const size_t start = (offset_ + alignment - 1) & ~(alignment - 1);
+            if (start > Bytes || size > Bytes - start)
+            {
+                throw std::bad_alloc();
+            }
+            offset_ = start + size;
+            return buffer_ + start;
+        }
+
+        /**
+         * @brief Allocates uninitialised storage for count objects of type U.
+         *
+         * @tparam U The element type.
+         * @param count Number of elements.
+         * @return Pointer to the first element.
+         */
+        template <typename U>
+        U *allocate(size_t count)
+        {
+            return static_cast<U *>(allocate(sizeof(U) * count, alignof(U)));
+        }
+
+        /**
+         * @brief Releases everything allocated from the arena.
+         *
+         * Advances the epoch, so every ArenaString and ArenaVector allocated before reads as empty.
+         */
+        void reset() noexcept
+        {
+            offset_ = 0;
+            ++epoch_;
+        }
+
+        /**
+         * @brief Gets the reset count, with a stable address for payload handles to check against.
+         */
+        const uint64_t &epoch() const noexcept
+        {
+            return epoch_;
+        }
+
+        /**
+         * @brief Gets the number of bytes in use.
+         */
+        size_t used() const noexcept
+        {
+            return offset_;
+        }
+
+        /**
+         * @brief Gets the arena capacity in bytes.
+         */
+        static constexpr size_t capacity() noexcept
+        {
+            return Bytes;
+        }
+
+    private:
+        size_t offset_ = 0;
+        uint64_t epoch_ = 0;
+        alignas(std::max_align_t) std::byte buffer_[Bytes];
+    };
+
+    /**
+     * @brief Concept for events that own a slot arena.
+     *
+     * RingBuffer resets arena() of every slot it hands out from next().
+     */
+    template <typename T>
+    concept ArenaEventConcept = requires(T &event) {
+        { event.arena().reset() } noexcept;
+    };
+
+    /**
+     * @brief Arena epoch a payload handle was allocated in.
+     *
+     * A handle whose arena has since been reset is stale: it reads as empty and its next mutation
+     * starts from fresh storage, so reusing a slot without clearing its payloads never aliases the
+     * arena's new allocations.
+     */
+    class ArenaEpochTag
+    {
+    public:
+        /**
+         * @brief Checks whether the handle's storage still belongs to its arena.
+         */
+        bool live() const noexcept
+        {
+            return arenaEpoch_ != nullptr && *arenaEpoch_ == epoch_;
+        }
+
+        /**
+         * @brief Binds the handle to the arena's current epoch.
+         *
+         * @return False if the handle was stale (or unbound) and its fields must be dropped.
+         */
+        template <typename Arena>
+        bool adopt(const Arena &arena) noexcept
+        {
+            const bool wasLive = arenaEpoch_ == &arena.epoch() && epoch_ == arena.epoch();
+            arenaEpoch_ = &arena.epoch();
+            epoch_ = arena.epoch();
+            return wasLive;
+        }
+
+        void forget() noexcept
+        {
+            arenaEpoch_ = nullptr;
+        }
+
+    private:
+        const uint64_t *arenaEpoch_ = nullptr;
+        uint64_t epoch_ = 0;
+    };
+
+    /**
+     * @brief String whose characters live in a slot arena.
+     *
+     * Reads as empty once the owning arena is reset, i.e. once the slot is reclaimed.
+     */
+    class ArenaString
+    {
+    public:
+        /**
+         * @brief Copies a string into the arena.
+         *
+         * @param arena The arena to allocate from.
+         * @param value The characters to copy.
+         */
+        template <typename Arena>
+        void assign(Arena &arena, std::string_view value)
+        {
+            char *data = arena.template allocate<char>(value.size());
+            std::memcpy(data, value.data(), value.size());
+            tag_.adopt(arena);
+            data_ = data;
+            size_ = value.size();
+        }
+
+        /**
+         * @brief Empties the string without touching the arena.
+         */
+        void clear() noexcept
+        {
+            data_ = nullptr;
+            size_ = 0;
+            tag_.forget();
+        }
+
+        std::string_view view() const noexcept
+        {
+            return {data(), size()};
+        }
+
+        operator std::string_view() const noexcept
+        {
+            return view();
+        }
+
+        const char *data() const noexcept
+        {
+            return tag_.live() ? data_ : nullptr;
+        }
+
+        size_t size() const noexcept
+        {
+            return tag_.live() ? size_ : 0;
+        }
+
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+    private:
+        const char *data_ = nullptr;
+        size_t size_ = 0;
+        ArenaEpochTag tag_;
+    };
+
+    /**
+     * @brief Growable vector whose elements live in a slot arena.
+     *
+     * Growth allocates a new block and copies; the old block is reclaimed with the arena.
+     * Reads as empty once the owning arena is reset, and grows from fresh storage after that.
+     *
+     * @tparam U Element type, must be trivially copyable.
+     */
+    template <typename U>
+    class ArenaVector
+    {
+        static_assert(std::is_trivially_copyable_v<U>, "ArenaVector elements must be trivially copyable");
+
+    public:
+        /**
+         * @brief Ensures capacity for at least n elements.
+         *
+         * @param arena The arena to allocate from.
+         * @param n Required capacity.
+         */
+        template <typename Arena>
+        void reserve(Arena &arena, size_t n)
+        {
+            revalidate(arena);
+            if (n <= capacity_)
+            {
+                return;
+            }
+            U *data = arena.template allocate<U>(n);
+            if (size_ > 0)
+            {
+                std::memcpy(data, data_, size_ * sizeof(U));
+            }
+            data_ = data;
+            capacity_ = n;
+        }
+
+        /**
+         * @brief Appends an element, growing geometrically inside the arena.
+         *
+         * @param arena The arena to allocate from.
+         * @param value The element to append.
+         */
+        template <typename Arena>
+        void push_back(Arena &arena, const U &value)
+        {
+            revalidate(arena);
+            if (size_ == capacity_)
+            {
+                reserve(arena, std::max<size_t>(capacity_ * 2, 4));
+            }
+            data_[size_++] = value;
+        }
+
+        /**
+         * @brief Replaces the contents with a copy of a range.
+         *
+         * @param arena The arena to allocate from.
+         * @param values Pointer to the first element.
+         * @param count Number of elements.
+         */
+        template <typename Arena>
+        void assign(Arena &arena, const U *values, size_t count)
+        {
+            clear();
+            reserve(arena, count);
+            if (count > 0)
+            {
+                std::memcpy(data_, values, count * sizeof(U));
+            }
+            size_ = count;
+        }
+
+        /**
+         * @brief Forgets every element and the storage, for reuse after an arena reset.
+         */
+        void clear() noexcept
+        {
+            data_ = nullptr;
+            size_ = 0;
+            capacity_ = 0;
+            tag_.forget();
+        }
+
+        U &operator[](size_t i) noexcept { return data()[i]; }
+        const U &operator[](size_t i) const noexcept { return data()[i]; }
+        U *begin() noexcept { return data(); }
+        U *end() noexcept { return data() + size(); }
+        const U *begin() const noexcept { return data(); }
+        const U *end() const noexcept { return data() + size(); }
+        U *data() noexcept { return tag_.live() ? data_ : nullptr; }
+        const U *data() const noexcept { return tag_.live() ? data_ : nullptr; }
+        size_t size() const noexcept { return tag_.live() ? size_ : 0; }
+        size_t capacity() const noexcept { return tag_.live() ? capacity_ : 0; }
+        bool empty() const noexcept { return size() == 0; }
+
+    private:
+        U *data_ = nullptr;
+        size_t size_ = 0;
+        size_t capacity_ = 0;
+        ArenaEpochTag tag_;
+
+        /**
+         * @brief Drops storage left over from before the arena's last reset.
+         */
+        template <typename Arena>
+        void revalidate(const Arena &arena) noexcept
+        {
+            if (!tag_.adopt(arena))
+            {
+                data_ = nullptr;
+                size_ = 0;
+                capacity_ = 0;
+            }
+        }
+    };
+
+} // namespace disruptor
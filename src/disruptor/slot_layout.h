@@ -0,0 +1,113 @@
+/**
+ * @file slot_layout.h
+ * @brief Defines slot layout policies controlling how events are placed in ring buffer storage.
+ */
+
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+#include "sequence.h"
+
+namespace disruptor
+{
+
+    /**
+     * @brief Concept for slot layout policies.
+     *
+     * A layout provides the slot wrapper stored for each event and the mapping from
+     * sequence to storage index. The mapping must be a bijection over [0, N).
+     */
+    template <typename L>
+    concept SlotLayoutConcept = requires(int64_t seq) {
+        typename L::template Slot<int64_t>;
+        { L::template index<int64_t, 8>(seq) } -> std::same_as<size_t>;
+    };
+
+    /**
+     * @brief Default layout: events stored contiguously, sequence k maps to slot k mod N.
+     *
+     * Smallest footprint, but small adjacent events share cache lines, so a producer writing
+     * slot k+1 can invalidate the line a consumer is reading for slot k.
+     */
+    struct PackedLayout
+    {
+        template <typename T>
+        struct Slot
+        {
+            T value;
+        };
+
+        template <typename T, size_t N>
+        static constexpr size_t index(int64_t sequence) noexcept
+        {
+            return static_cast<size_t>(sequence) & (N - 1);
+        }
+    };
+
+    /**
+     * @brief Pads every slot to a whole number of cache lines.
+     *
+     * Lines = 2 keeps neighbouring slots apart even with adjacent-line (spatial) prefetchers.
+     *
+     * @tparam Lines Number of cache lines each slot is aligned to.
+     */
+    template <size_t Lines = 1>
+    struct PaddedLayout
+    {
+        static_assert(Lines > 0, "Padded slots must span at least one cache line");
+
+        template <typename T>
+        struct alignas(kSizeOfCacheLine * Lines) Slot
+        {
+            T value;
+        };
+
+        template <typename T, size_t N>
+        static constexpr size_t index(int64_t sequence) noexcept
+        {
+            return static_cast<size_t>(sequence) & (N - 1);
+        }
+    };
+
+    /**
+     * @brief Keeps events packed but permutes the index so consecutive sequences land on different lines.
+     *
+     * Storage is viewed as a (N / stride) x stride matrix and sequences fill it column-major, so
+     * sequences k and k+1 sit stride slots apart. The stride is the smallest power of two for which
+     * neighbours never share a line: a line's worth of slots when slots tile lines exactly, and
+     * otherwise enough that a whole line's worth of bytes separates them, since such slots straddle
+     * line boundaries. Same footprint as PackedLayout.
+     */
+    struct PermutedLayout
+    {
+        template <typename T>
+        struct Slot
+        {
+            T value;
+        };
+
+        template <typename T, size_t N>
+        static constexpr size_t index(int64_t sequence) noexcept
+        {
+            constexpr size_t size = sizeof(Slot<T>);
+            constexpr size_t stride = size % kSizeOfCacheLine == 0   ? 1
+                                      : kSizeOfCacheLine % size == 0 ? kSizeOfCacheLine / size
+                                                                     : std::bit_ceil(1 + (kSizeOfCacheLine + size - 2) / size);
+            const size_t i = static_cast<size_t>(sequence) & (N - 1);
+            if constexpr (stride == 1 || N <= stride)
+            {
+                return i;
+            }
+            else
+            {
+                constexpr size_t rows = N / stride;
+                return (i & (rows - 1)) * stride + (i >> std::countr_zero(rows));
+            }
+        }
+    };
+
+} // namespace disruptor
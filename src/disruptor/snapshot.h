@@ -0,0 +1,413 @@
+/**
+ * @file snapshot.h
+ * @brief Defines the SnapshotHandler, taking asynchronous state snapshots at batch boundaries.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "event_handler.h"
+
+namespace disruptor
+{
+
+    constexpr uint64_t kSnapshotMagic = 0x50414e5352505344; // "DSPRSNAP"
+    constexpr uint32_t kSnapshotVersion = 1;
+
+    /**
+     * @brief Header of a snapshot file, followed by the encoded state.
+     */
+    struct SnapshotHeader
+    {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t reserved;
+        int64_t sequence;
+        uint64_t payloadSize;
+    };
+
+    /**
+     * @brief Concept for a snapshot codec.
+     *
+     * encode() appends the state to a byte buffer; decode() restores it.
+     */
+    template <typename C, typename State>
+    concept SnapshotCodecConcept = requires(const State &state, State &out, std::vector<std::byte> &buffer,
+                                            std::span<const std::byte> bytes) {
+        { C::encode(state, buffer) } -> std::same_as<void>;
+        { C::decode(bytes, out) } -> std::same_as<void>;
+    };
+
+    /**
+     * @brief Codec copying the bytes of a trivially copyable state.
+     *
+     * @tparam State The state type.
+     */
+    template <typename State>
+    struct TrivialSnapshotCodec
+    {
+        static_assert(std::is_trivially_copyable_v<State>, "TrivialSnapshotCodec needs a trivially copyable state");
+
+        static void encode(const State &state, std::vector<std::byte> &buffer)
+        {
+            const auto *bytes = reinterpret_cast<const std::byte *>(&state);
+            buffer.insert(buffer.end(), bytes, bytes + sizeof(State));
+        }
+
+        static void decode(std::span<const std::byte> bytes, State &out)
+        {
+            if (bytes.size() != sizeof(State))
+            {
+                throw std::runtime_error("Snapshot size does not match state");
+            }
+            std::memcpy(&out, bytes.data(), sizeof(State));
+        }
+    };
+
+    /**
+     * @brief Builds the path of the snapshot taken at a sequence.
+     *
+     * @param directory The snapshot directory.
+     * @param sequence Last sequence reflected in the snapshot.
+     * @return The snapshot path.
+     */
+    inline std::filesystem::path snapshotPath(const std::filesystem::path &directory, int64_t sequence)
+    {
+        char name[48];
+        std::snprintf(name, sizeof(name), "snapshot-%020lld.snap", static_cast<long long>(sequence));
+        return directory / name;
+    }
+
+    /**
+     * @brief Handler adapter snapshotting the state of a wrapped handler.
+     *
+     * At the end of a batch, once a snapshot has been requested or everyN events have passed, the
+     * state is copied into a second buffer and the processor carries on; a background thread encodes
+     * that copy and writes it atomically (temporary file, fsync, rename). The processor is only paused
+     * for the copy, and the copy reflects exactly the events up to the batch's last sequence. If the
+     * previous snapshot is still being written the new one is taken at a later batch boundary.
+     * Recovery loads the latest snapshot and replays the journal from the sequence after it.
+     *
+     * @tparam T The type of event.
+     * @tparam State The state type, copy-assignable.
+     * @tparam Handler The wrapped handler type, which updates the state.
+     * @tparam Codec The snapshot codec (default: TrivialSnapshotCodec<State>).
+     */
+    template <typename T, typename State, typename Handler, typename Codec = TrivialSnapshotCodec<State>>
+        requires SnapshotCodecConcept<Codec, State>
+    class SnapshotHandler : public EventHandler<T>
+    {
+    public:
+        /**
+         * @brief Constructs a SnapshotHandler and starts its writer thread.
+         *
+         * @param handler The handler receiving events.
+         * @param state The state owned by the handler.
+         * @param directory Directory holding the snapshots, created if missing.
+         * @param everyN Take a snapshot every everyN events, 0 for on request only (default: 0).
+         */
+        SnapshotHandler(Handler &handler, const State &state, std::filesystem::path directory, int64_t everyN = 0)
+            : handler_(handler),
+              state_(state),
+              copy_(state),
+              directory_(std::move(directory)),
+              everyN_(everyN)
+        {
+            if (everyN < 0)
+            {
+                throw std::invalid_argument("Invalid everyN in SnapshotHandler");
+            }
+            std::filesystem::create_directories(directory_);
+            writer_ = std::thread([this]
+                                  { writeLoop(); });
+        }
+
+        ~SnapshotHandler() override
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            condition_.notify_one();
+            writer_.join();
+        }
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        SnapshotHandler(const SnapshotHandler &) = delete;
+        SnapshotHandler &operator=(const SnapshotHandler &) = delete;
+        SnapshotHandler(SnapshotHandler &&) = delete;
+        SnapshotHandler &operator=(SnapshotHandler &&) = delete;
+
+        void onEvent(T &event, int64_t sequence, bool endOfBatch) override
+        {
+            handler_.onEvent(event, sequence, endOfBatch);
+            ++sinceSnapshot_;
+
+            if (endOfBatch && (requested_.load(std::memory_order_relaxed) || (everyN_ > 0 && sinceSnapshot_ >= everyN_)))
+            {
+                takeSnapshot(sequence);
+            }
+        }
+
+        void onBatchStart(int64_t batchSize, int64_t queueDepth) override
+        {
+            handler_.onBatchStart(batchSize, queueDepth);
+        }
+
+        void onStart() override
+        {
+            handler_.onStart();
+        }
+
+        void onShutdown() override
+        {
+            handler_.onShutdown();
+        }
+
+        void onTimeout(int64_t sequence) override
+        {
+            handler_.onTimeout(sequence);
+        }
+
+        void setSequenceCallback(Sequence &sequenceCallback) override
+        {
+            handler_.setSequenceCallback(sequenceCallback);
+        }
+
+        /**
+         * @brief Requests a snapshot at the next batch boundary. Safe to call from any thread.
+         */
+        void requestSnapshot()
+        {
+            requested_.store(true, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Gets the sequence of the last snapshot written, or -1 if none.
+         */
+        int64_t getLastSnapshotSequence() const
+        {
+            return lastWritten_.load(std::memory_order_acquire);
+        }
+
+    private:
+        Handler &handler_;
+        const State &state_;
+        State copy_;
+        std::filesystem::path directory_;
+        int64_t everyN_;
+        int64_t sinceSnapshot_ = 0;
+        std::atomic<bool> requested_{false};
+        std::atomic<bool> busy_{false};
+        std::atomic<int64_t> lastWritten_{-1};
+        int64_t copySequence_ = -1;
+        std::exception_ptr error_;
+
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        bool stopping_ = false;
+        std::thread writer_;
+
+        void takeSnapshot(int64_t sequence)
+        {
+            if (busy_.load(std::memory_order_acquire))
+            {
+                return;
+            }
+            if (error_)
+            {
+                // surfaced through the processor's exception handler
+                std::rethrow_exception(std::exchange(error_, nullptr));
+            }
+
+            copy_ = state_;
+            copySequence_ = sequence;
+            sinceSnapshot_ = 0;
+            requested_.store(false, std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                busy_.store(true, std::memory_order_relaxed);
+            }
+            condition_.notify_one();
+        }
+
+        void writeLoop()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (true)
+            {
+                condition_.wait(lock, [this]
+                                { return busy_.load(std::memory_order_relaxed) || stopping_; });
+                if (!busy_.load(std::memory_order_relaxed))
+                {
+                    return;
+                }
+                lock.unlock();
+
+                try
+                {
+                    write(copySequence_, copy_);
+                    lastWritten_.store(copySequence_, std::memory_order_release);
+                }
+                catch (...)
+                {
+                    error_ = std::current_exception();
+                }
+
+                lock.lock();
+                busy_.store(false, std::memory_order_release);
+            }
+        }
+
+        void write(int64_t sequence, const State &state)
+        {
+            std::vector<std::byte> payload;
+            Codec::encode(state, payload);
+            const SnapshotHeader header{kSnapshotMagic, kSnapshotVersion, 0, sequence, payload.size()};
+
+            const auto path = snapshotPath(directory_, sequence);
+            auto temporary = path;
+            temporary += ".tmp";
+
+            const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "open snapshot " + temporary.string());
+            }
+            if (!writeAll(fd, &header, sizeof(header)) || !writeAll(fd, payload.data(), payload.size()) ||
+                ::fsync(fd) != 0)
+            {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "write snapshot " + temporary.string());
+            }
+            ::close(fd);
+
+            std::filesystem::rename(temporary, path);
+            const int directoryFd = ::open(directory_.c_str(), O_RDONLY | O_DIRECTORY);
+            if (directoryFd >= 0)
+            {
+                ::fsync(directoryFd);
+                ::close(directoryFd);
+            }
+        }
+
+        static bool writeAll(int fd, const void *data, size_t size)
+        {
+            const auto *bytes = static_cast<const char *>(data);
+            while (size > 0)
+            {
+                const ssize_t written = ::write(fd, bytes, size);
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    return false;
+                }
+                bytes += written;
+                size -= static_cast<size_t>(written);
+            }
+            return true;
+        }
+    };
+
+    /**
+     * @brief Loads the most recent valid snapshot of a directory.
+     *
+     * A snapshot whose header or size is inconsistent, or that the codec fails to decode, is skipped
+     * in favour of the next older one. out is only assigned from a snapshot that decoded completely.
+     *
+     * @tparam State The state type.
+     * @tparam Codec The snapshot codec (default: TrivialSnapshotCodec<State>).
+     * @param directory The snapshot directory.
+     * @param out Receives the state.
+     * @return The snapshot's sequence, or -1 if there is none; replay the journal from the next one.
+     */
+    template <typename State, typename Codec = TrivialSnapshotCodec<State>>
+        requires SnapshotCodecConcept<Codec, State>
+    int64_t loadLatestSnapshot(const std::filesystem::path &directory, State &out)
+    {
+        if (!std::filesystem::exists(directory))
+        {
+            return -1;
+        }
+
+        // names sort in sequence order; temporary files never match the extension
+        std::vector<std::filesystem::path> snapshots;
+        for (const auto &entry : std::filesystem::directory_iterator(directory))
+        {
+            const std::string name = entry.path().filename().string();
+            if (name.starts_with("snapshot-") && name.ends_with(".snap"))
+            {
+                snapshots.push_back(entry.path());
+            }
+        }
+        std::sort(snapshots.rbegin(), snapshots.rend());
+
+        for (const auto &path : snapshots)
+        {
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                continue;
+            }
+            SnapshotHeader header;
+            std::vector<std::byte> payload;
+            struct stat status;
+            // the payload fills the rest of the file, so a corrupt size never drives the allocation
+            bool valid = ::fstat(fd, &status) == 0 &&
+                         ::read(fd, &header, sizeof(header)) == static_cast<ssize_t>(sizeof(header)) &&
+                         header.magic == kSnapshotMagic && header.version == kSnapshotVersion &&
+                         header.payloadSize == static_cast<uint64_t>(status.st_size) - sizeof(header);
+            if (valid)
+            {
+                payload.resize(header.payloadSize);
+                valid = ::read(fd, payload.data(), payload.size()) == static_cast<ssize_t>(payload.size());
+            }
+            ::close(fd);
+
+            if (valid)
+            {
+                try
+                {
+                    State decoded(out);
+                    Codec::decode(payload, decoded);
+                    out = std::move(decoded);
+                    return header.sequence;
+                }
+                catch (const std::exception &)
+                {
+                }
+            }
+        }
+        return -1;
+    }
+
+} // namespace disruptor
@@ -0,0 +1,255 @@
+/**
+ * @file soa_ring_buffer.h
+ * @brief Defines the SoARingBuffer class, a struct-of-arrays ring buffer for columnar event fields.
+ */
+
+#pragma once
+
+#include <array>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include "sequencer.h"
+
+namespace disruptor
+{
+
+    /**
+     * @brief Concept for SoA field declarations.
+     *
+     * A field is a tag type naming the stored value type, e.g.
+     * `struct Price { using type = double; };`.
+     */
+    template <typename F>
+    concept SoAFieldConcept = requires { typename F::type; };
+
+    /**
+     * @brief Ring buffer storing each event field in its own array.
+     *
+     * get(seq) returns a lightweight Reference bundle instead of a T&, so handlers that read one or
+     * two fields only touch those columns. Batch handlers can use column<Field>() to scan a field
+     * contiguously; sequence s lives at index s & (N - 1) of every column.
+     *
+     * @tparam N The size of the buffer (must be power of 2).
+     * @tparam Sequencer The sequencer type used for managing sequences.
+     * @tparam Fields Field tags, each declaring its value type as `type`.
+     */
+    template <
+        size_t N,
+        SequencerConcept Sequencer,
+        SoAFieldConcept... Fields>
+    class SoARingBuffer
+    {
+        static_assert(
+            (N & (N - 1)) == 0,
+            "Buffer size must be power of 2");
+        static_assert(sizeof...(Fields) > 0, "SoARingBuffer needs at least one field");
+
+        template <typename Field>
+        struct alignas(kSizeOfCacheLine) Column
+        {
+            std::array<typename Field::type, N> values{};
+        };
+
+    public:
+        /**
+         * @brief Proxy for the event stored at one sequence.
+         *
+         * Cheap to copy; holds only the buffer and the slot index.
+         */
+        class Reference
+        {
+        public:
+            Reference(SoARingBuffer &buffer, size_t index) noexcept
+                : buffer_(&buffer), index_(index) {}
+
+            /**
+             * @brief Gets a reference to one field of the event.
+             *
+             * @tparam Field The field tag.
+             * @return Reference to the field value.
+             */
+            template <typename Field>
+            typename Field::type &get() const noexcept
+            {
+                return buffer_->template column<Field>()[index_];
+            }
+
+            /**
+             * @brief Gets the slot index shared by all columns.
+             */
+            size_t index() const noexcept
+            {
+                return index_;
+            }
+
+        private:
+            SoARingBuffer *buffer_;
+            size_t index_;
+        };
+
+        /**
+         * @brief Constructs a SoARingBuffer with value-initialised columns.
+         *
+         * @param sequencer Reference to the sequencer.
+         */
+        explicit SoARingBuffer(Sequencer &sequencer)
+            : sequencer_(sequencer) {}
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        SoARingBuffer(const SoARingBuffer &) = delete;
+        SoARingBuffer &operator=(const SoARingBuffer &) = delete;
+        SoARingBuffer(SoARingBuffer &&) = delete;
+        SoARingBuffer &operator=(SoARingBuffer &&) = delete;
+
+        /**
+         * @brief Claims the next n sequences for publication.
+         *
+         * @param n Number of sequences to claim (default 1).
+         * @return The last claimed sequence number.
+         */
+        int64_t next(int64_t n = 1)
+        {
+            return sequencer_.next(n);
+        }
+
+        /**
+         * @brief Publishes an event at the given sequence.
+         *
+         * @param sequence The sequence to publish.
+         */
+        void publish(int64_t sequence)
+        {
+            sequencer_.publish(sequence);
+        }
+
+        /**
+         * @brief Publishes a claimed range of sequences in one call.
+         *
+         * @param lo First sequence of the range.
+         * @param hi Last sequence of the range.
+         */
+        void publish(int64_t lo, int64_t hi)
+        {
+            sequencer_.publish(lo, hi);
+        }
+
+        /**
+         * @brief Gets a reference bundle for the event at the given sequence.
+         *
+         * @param sequence The sequence number.
+         * @return Proxy giving access to every field of the event.
+         */
+        Reference get(int64_t sequence) noexcept
+        {
+            return Reference(*this, static_cast<size_t>(sequence) & (N - 1));
+        }
+
+        /**
+         * @brief Gets a single field of the event at the given sequence.
+         *
+         * @tparam Field The field tag.
+         * @param sequence The sequence number.
+         * @return Reference to the field value.
+         */
+        template <typename Field>
+        typename Field::type &get(int64_t sequence) noexcept
+        {
+            return column<Field>()[static_cast<size_t>(sequence) & (N - 1)];
+        }
+
+        /**
+         * @brief Gets a whole column for per-field batch processing.
+         *
+         * @tparam Field The field tag.
+         * @return Span over the N values of the field.
+         */
+        template <typename Field>
+        std::span<typename Field::type, N> column() noexcept
+        {
+            return std::get<Column<Field>>(columns_).values;
+        }
+
+        /**
+         * @brief Gets a whole column for per-field batch processing.
+         *
+         * @tparam Field The field tag.
+         * @return Const span over the N values of the field.
+         */
+        template <typename Field>
+        std::span<const typename Field::type, N> column() const noexcept
+        {
+            return std::get<Column<Field>>(columns_).values;
+        }
+
+        /**
+         * @brief Prefetches every column entry of the slot at the given sequence.
+         *
+         * @param sequence The sequence number.
+         */
+        void prefetch(int64_t sequence) const
+        {
+            const size_t index = static_cast<size_t>(sequence) & (N - 1);
+            (__builtin_prefetch(&std::get<Column<Fields>>(columns_).values[index], 0, 3), ...);
+        }
+
+        /**
+         * @brief Sets the gating sequences for the sequencer.
+         *
+         * @param sequences Vector of pointers to gating sequences.
+         */
+        void setGatingSequences(const std::vector<Sequence *> &sequences)
+        {
+            sequencer_.setGatingSequences(sequences);
+        }
+
+        /**
+         * @brief Adds gating sequences while the producer may be running.
+         *
+         * @param sequences Vector of pointers to gating sequences, started at the current cursor.
+         */
+        void addGatingSequences(const std::vector<Sequence *> &sequences)
+        {
+            sequencer_.addGatingSequences(sequences);
+        }
+
+        /**
+         * @brief Removes a gating sequence while the producer may be running.
+         *
+         * @param sequence The gating sequence to remove.
+         * @return True if the sequence was gating the producer.
+         */
+        bool removeGatingSequence(const Sequence &sequence)
+        {
+            return sequencer_.removeGatingSequence(sequence);
+        }
+
+        /**
+         * @brief Gets the current cursor position.
+         *
+         * @return The cursor sequence.
+         */
+        int64_t getCursor() const
+        {
+            return sequencer_.getCursor();
+        }
+
+        /**
+         * @brief Gets the minimum gating sequence.
+         *
+         * @return The minimum gating sequence.
+         */
+        int64_t getMinimumGatingSequence() const
+        {
+            return sequencer_.getMinimumGatingSequence();
+        }
+
+    private:
+        std::tuple<Column<Fields>...> columns_;
+        Sequencer &sequencer_;
+    };
+
+} // namespace disruptor
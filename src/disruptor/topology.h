@@ -0,0 +1,482 @@
+/**
+ * @file topology.h
+ * @brief Defines the Topology registry, dumping a running pipeline's sequences and processor states as JSON.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "event_processor.h"
+#include "sequence.h"
+
+namespace disruptor
+{
+
+    /**
+     * @brief Registry of a pipeline's sequencers, barriers, processors and gating sequences for introspection.
+     *
+     * Components are registered once, from one thread, while the pipeline is being built; registered
+     * objects must outlive the Topology. dumpJson() then walks the registry with acquire loads of the
+     * live sequences and relaxed loads of the counters only: no locks, no allocation and no library
+     * formatting, so it may run on an admin thread or in a signal handler while the pipeline runs.
+     * Values are read one at a time, so a dump is not an atomic snapshot; each consumer's sequence is
+     * read before its sequencer's cursor, so racing with the producer cannot make a lag negative.
+     *
+     * @tparam MaxNodes Maximum number of components of each kind (default: 32).
+     */
+    template <size_t MaxNodes = 32>
+    class Topology
+    {
+    public:
+        Topology() = default;
+
+        /**
+         * @brief Non-copyable and non-movable.
+         */
+        Topology(const Topology &) = delete;
+        Topology &operator=(const Topology &) = delete;
+        Topology(Topology &&) = delete;
+        Topology &operator=(Topology &&) = delete;
+
+        /**
+         * @brief Registers a sequencer or ring buffer.
+         *
+         * @param name Name in the dump; must outlive the Topology (e.g., a literal).
+         * @param sequencer Anything with getCursor() and getMinimumGatingSequence().
+         * @return The id to pass when registering the components reading from it.
+         */
+        template <typename Sequencer>
+        size_t addSequencer(const char *name, const Sequencer &sequencer)
+        {
+            SequencerNode node{name, waitStrategyName<Sequencer>(), -1, &sequencer,
+                               [](const void *s)
+                               { return static_cast<const Sequencer *>(s)->getCursor(); },
+                               [](const void *s)
+                               { return static_cast<const Sequencer *>(s)->getMinimumGatingSequence(); }};
+            if constexpr (requires { Sequencer::kBufferSize; })
+            {
+                node.bufferSize = static_cast<int64_t>(Sequencer::kBufferSize);
+            }
+            return append(sequencers_, sequencerCount_, node);
+        }
+
+        /**
+         * @brief Registers a sequence barrier.
+         *
+         * @param name Name in the dump.
+         * @param barrier The barrier.
+         * @param sequencer Id of the sequencer the barrier reads from.
+         */
+        template <typename Barrier>
+        void addBarrier(const char *name, const Barrier &barrier, size_t sequencer)
+        {
+            append(barriers_, barrierCount_,
+                   BarrierNode{name, checkSequencer(sequencer), &barrier,
+                               [](const void *b)
+                               { return static_cast<const Barrier *>(b)->getCursor(); },
+                               [](const void *b)
+                               { return static_cast<const Barrier *>(b)->isAlerted(); }});
+        }
+
+        /**
+         * @brief Registers an event processor.
+         *
+         * @param name Name in the dump.
+         * @param processor The processor; its state and batch counters are reported when it has them.
+         * @param sequencer Id of the sequencer the processor consumes.
+         */
+        template <typename Processor>
+        void addProcessor(const char *name, Processor &processor, size_t sequencer)
+        {
+            ProcessorNode node{name, checkSequencer(sequencer), &processor.getSequence(), &processor, nullptr, nullptr};
+            if constexpr (requires(const Processor &p) { p.getState(); })
+            {
+                node.state = [](const void *p)
+                { return static_cast<const Processor *>(p)->getState(); };
+            }
+            if constexpr (requires(const Processor &p) { p.getBatchStats(); })
+            {
+                node.stats = [](const void *p)
+                { return static_cast<const Processor *>(p)->getBatchStats(); };
+            }
+            append(processors_, processorCount_, node);
+        }
+
+        /**
+         * @brief Registers a gating sequence not owned by a registered processor.
+         *
+         * @param name Name in the dump.
+         * @param sequence The sequence.
+         * @param sequencer Id of the sequencer it gates.
+         */
+        void addSequence(const char *name, const Sequence &sequence, size_t sequencer)
+        {
+            append(sequences_, sequenceCount_, SequenceNode{name, checkSequencer(sequencer), &sequence});
+        }
+
+        /**
+         * @brief Writes the current state as one JSON object. Lock-free and async-signal-safe.
+         *
+         * @param buffer Destination, NUL-terminated on return when capacity > 0.
+         * @param capacity Size of buffer in bytes.
+         * @return The JSON length, or 0 if it did not fit (buffer then holds an empty string).
+         */
+        size_t dumpJson(char *buffer, size_t capacity) const noexcept
+        {
+            JsonWriter out{buffer, capacity};
+            out.raw("{\"sequencers\":[");
+            const size_t sequencers = sequencerCount_.load(std::memory_order_acquire);
+            for (size_t i = 0; i < sequencers; ++i)
+            {
+                const SequencerNode &node = sequencers_[i];
+                const int64_t minimum = node.minimumGating(node.object);
+                const int64_t cursor = node.cursor(node.object);
+                out.raw(i == 0 ? "{" : ",{");
+                out.field("name", node.name);
+                out.field("waitStrategy", node.waitStrategy);
+                if (node.bufferSize > 0)
+                {
+                    out.field("bufferSize", node.bufferSize);
+                }
+                out.field("cursor", cursor);
+                // with no gating sequences the minimum is the int64 maximum
+                out.field("minimumGating", std::min(minimum, cursor));
+                out.field("occupancy", cursor - std::min(minimum, cursor), false);
+                out.raw("}");
+            }
+
+            out.raw("],\"barriers\":[");
+            const size_t barriers = barrierCount_.load(std::memory_order_acquire);
+            for (size_t i = 0; i < barriers; ++i)
+            {
+                const BarrierNode &node = barriers_[i];
+                const int64_t available = node.available(node.object);
+                const int64_t cursor = cursorOf(node.sequencer);
+                out.raw(i == 0 ? "{" : ",{");
+                out.field("name", node.name);
+                out.field("sequencer", sequencers_[node.sequencer].name);
+                out.field("available", available);
+                out.field("lag", cursor - available);
+                out.field("alerted", node.alerted(node.object), false);
+                out.raw("}");
+            }
+
+            out.raw("],\"processors\":[");
+            const size_t processors = processorCount_.load(std::memory_order_acquire);
+            for (size_t i = 0; i < processors; ++i)
+            {
+                const ProcessorNode &node = processors_[i];
+                const int64_t sequence = node.sequence->get();
+                const int64_t cursor = cursorOf(node.sequencer);
+                out.raw(i == 0 ? "{" : ",{");
+                out.field("name", node.name);
+                out.field("sequencer", sequencers_[node.sequencer].name);
+                if (node.state != nullptr)
+                {
+                    out.field("state", stateName(node.state(node.object)));
+                }
+                out.field("sequence", sequence);
+                out.field("lag", cursor - sequence, node.stats != nullptr);
+                if (node.stats != nullptr)
+                {
+                    const BatchStats stats = node.stats(node.object);
+                    out.field("batches", stats.batches);
+                    out.field("events", stats.events);
+                    out.field("maxBatch", stats.maxBatch);
+                    out.field("lastBatch", stats.lastBatch, false);
+                }
+                out.raw("}");
+            }
+
+            out.raw("],\"sequences\":[");
+            const size_t sequences = sequenceCount_.load(std::memory_order_acquire);
+            for (size_t i = 0; i < sequences; ++i)
+            {
+                const SequenceNode &node = sequences_[i];
+                const int64_t sequence = node.sequence->get();
+                const int64_t cursor = cursorOf(node.sequencer);
+                out.raw(i == 0 ? "{" : ",{");
+                out.field("name", node.name);
+                out.field("sequencer", sequencers_[node.sequencer].name);
+                out.field("sequence", sequence);
+                out.field("lag", cursor - sequence, false);
+                out.raw("}");
+            }
+            out.raw("]}");
+            return out.finish();
+        }
+
+        /**
+         * @brief Gets the current state as a JSON string. Allocates, so not for signal handlers.
+         */
+        std::string toJson() const
+        {
+            std::string json(4096, '\0');
+            for (;;)
+            {
+                const size_t length = dumpJson(json.data(), json.size());
+                if (length != 0)
+                {
+                    json.resize(length);
+                    return json;
+                }
+                json.resize(json.size() * 2);
+            }
+        }
+
+    private:
+        struct SequencerNode
+        {
+            const char *name;
+            const char *waitStrategy;
+            int64_t bufferSize; // -1 if the type does not expose it
+            const void *object;
+            int64_t (*cursor)(const void *);
+            int64_t (*minimumGating)(const void *);
+        };
+
+        struct BarrierNode
+        {
+            const char *name;
+            size_t sequencer;
+            const void *object;
+            int64_t (*available)(const void *);
+            bool (*alerted)(const void *);
+        };
+
+        struct ProcessorNode
+        {
+            const char *name;
+            size_t sequencer;
+            const Sequence *sequence;
+            const void *object;
+            ProcessorState (*state)(const void *);
+            BatchStats (*stats)(const void *);
+        };
+
+        struct SequenceNode
+        {
+            const char *name;
+            size_t sequencer;
+            const Sequence *sequence;
+        };
+
+        /**
+         * @brief Bounded JSON output; once full, further output is dropped and finish() reports 0.
+         */
+        class JsonWriter
+        {
+        public:
+            JsonWriter(char *buffer, size_t capacity) noexcept : buffer_(buffer), capacity_(capacity) {}
+
+            void raw(const char *text) noexcept
+            {
+                while (*text != '\0')
+                {
+                    put(*text++);
+                }
+            }
+
+            void string(const char *text) noexcept
+            {
+                static constexpr char kHex[] = "0123456789abcdef";
+                put('"');
+                for (; *text != '\0'; ++text)
+                {
+                    const unsigned char c = static_cast<unsigned char>(*text);
+                    if (c == '"' || c == '\\')
+                    {
+                        put('\\');
+                        put(static_cast<char>(c));
+                    }
+                    else if (c < 0x20)
+                    {
+                        raw("\\u00");
+                        put(kHex[c >> 4]);
+                        put(kHex[c & 0xf]);
+                    }
+                    else
+                    {
+                        put(static_cast<char>(c));
+                    }
+                }
+                put('"');
+            }
+
+            void number(int64_t value) noexcept
+            {
+                if (value < 0)
+                {
+                    put('-');
+                    // negate in unsigned arithmetic so INT64_MIN does not overflow
+                    number(uint64_t{0} - static_cast<uint64_t>(value));
+                }
+                else
+                {
+                    number(static_cast<uint64_t>(value));
+                }
+            }
+
+            void number(uint64_t value) noexcept
+            {
+                char digits[20];
+                size_t count = 0;
+                do
+                {
+                    digits[count++] = static_cast<char>('0' + value % 10);
+                    value /= 10;
+                } while (value != 0);
+                while (count > 0)
+                {
+                    put(digits[--count]);
+                }
+            }
+
+            void field(const char *key, const char *value, bool more = true) noexcept
+            {
+                writeKey(key);
+                string(value);
+                separator(more);
+            }
+
+            void field(const char *key, int64_t value, bool more = true) noexcept
+            {
+                writeKey(key);
+                number(value);
+                separator(more);
+            }
+
+            void field(const char *key, uint64_t value, bool more = true) noexcept
+            {
+                writeKey(key);
+                number(value);
+                separator(more);
+            }
+
+            void field(const char *key, bool value, bool more = true) noexcept
+            {
+                writeKey(key);
+                raw(value ? "true" : "false");
+                separator(more);
+            }
+
+            size_t finish() noexcept
+            {
+                if (capacity_ == 0)
+                {
+                    return 0;
+                }
+                if (length_ >= capacity_)
+                {
+                    buffer_[0] = '\0';
+                    return 0;
+                }
+                buffer_[length_] = '\0';
+                return length_;
+            }
+
+        private:
+            char *buffer_;
+            size_t capacity_;
+            size_t length_ = 0;
+
+            void put(char c) noexcept
+            {
+                // one byte is kept for the terminator
+                if (length_ + 1 < capacity_)
+                {
+                    buffer_[length_] = c;
+                }
+                ++length_;
+            }
+
+            void writeKey(const char *key) noexcept
+            {
+                string(key);
+                put(':');
+            }
+
+            void separator(bool more) noexcept
+            {
+                if (more)
+                {
+                    put(',');
+                }
+            }
+        };
+
+        std::array<SequencerNode, MaxNodes> sequencers_{};
+        std::array<BarrierNode, MaxNodes> barriers_{};
+        std::array<ProcessorNode, MaxNodes> processors_{};
+        std::array<SequenceNode, MaxNodes> sequences_{};
+        std::atomic<size_t> sequencerCount_{0};
+        std::atomic<size_t> barrierCount_{0};
+        std::atomic<size_t> processorCount_{0};
+        std::atomic<size_t> sequenceCount_{0};
+
+        template <typename Sequencer>
+        static const char *waitStrategyName() noexcept
+        {
+            if constexpr (requires { Sequencer::WaitStrategyType::kName; })
+            {
+                return Sequencer::WaitStrategyType::kName;
+            }
+            else
+            {
+                return "unknown";
+            }
+        }
+
+        static const char *stateName(ProcessorState state) noexcept
+        {
+            switch (state)
+            {
+            case IDLE:
+                return "IDLE";
+            case HALTED:
+                return "HALTED";
+            case RUNNING:
+                return "RUNNING";
+            }
+            return "UNKNOWN";
+        }
+
+        /**
+         * @brief Appends a node, publishing it to concurrent dumps with a release store of the count.
+         */
+        template <typename Node>
+        static size_t append(std::array<Node, MaxNodes> &nodes, std::atomic<size_t> &count, const Node &node)
+        {
+            const size_t index = count.load(std::memory_order_relaxed);
+            if (index == MaxNodes)
+            {
+                throw std::length_error("Topology is full");
+            }
+            nodes[index] = node;
+            count.store(index + 1, std::memory_order_release);
+            return index;
+        }
+
+        size_t checkSequencer(size_t sequencer) const
+        {
+            if (sequencer >= sequencerCount_.load(std::memory_order_relaxed))
+            {
+                throw std::invalid_argument("Unknown sequencer in Topology");
+            }
+            return sequencer;
+        }
+
+        int64_t cursorOf(size_t sequencer) const noexcept
+        {
+            return sequencers_[sequencer].cursor(sequencers_[sequencer].object);
+        }
+    };
+
+} // namespace disruptor
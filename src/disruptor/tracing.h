@@ -0,0 +1,288 @@
+/**
+ * @file tracing.h
+ * @brief Defines per-slot latency tracing: the Traced event wrapper, the TracingEventHandler and the TraceCollector.
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "event_handler.h"
+#include "sequence.h"
+#include "tsc_clock.h"
+
+namespace disruptor
+{
+
+    /**
+     * @brief Reads the clock used for trace stamps, in nanoseconds.
+     */
+    inline int64_t traceNow() noexcept
+    {
+        return TscClock::nowNs();
+    }
+
+    /**
+     * @brief One stage's completion stamp, alone on its cache line.
+     */
+    struct alignas(kSizeOfCacheLine) StageStamp
+    {
+        int64_t ns = 0;
+    };
+
+    /**
+     * @brief Trace stamps carried by a slot: publication, then one completion per stage.
+     *
+     * Each field has a single writer, and readers are ordered behind the writer by the ring's own
+     * sequences, so no atomics are involved. Every stamp has its own cache line, off the payload, so
+     * stages running in parallel on the same slot (the middle of a diamond) do not false-share; this
+     * costs one line per stage and one for the publication stamp in every slot.
+     *
+     * @tparam Stages Number of traced stages.
+     */
+    template <size_t Stages>
+    struct alignas(kSizeOfCacheLine) TraceBlock
+    {
+        int64_t publishNs = 0;
+        std::array<StageStamp, Stages> stageNs{};
+    };
+
+    /**
+     * @brief Ring event adding a TraceBlock to an event.
+     *
+     * @tparam T The event type.
+     * @tparam Stages Number of traced stages.
+     */
+    template <typename T, size_t Stages>
+    struct Traced
+    {
+        T value{};
+        TraceBlock<Stages> trace;
+    };
+
+    /**
+     * @brief Stamps the publication time of a traced event. Call just before publish().
+     *
+     * @param event The claimed event.
+     */
+    template <typename T, size_t Stages>
+    inline void stampPublish(Traced<T, Stages> &event) noexcept
+    {
+        event.trace.publishNs = traceNow();
+    }
+
+    /**
+     * @brief Handler adapter running a handler on Traced<T> and stamping the stage's completion.
+     *
+     * The stamp is written after the inner handler returns, before the processor advances its
+     * Sequence at the end of the batch, so consumers gated on this stage always see it.
+     *
+     * @tparam T The event type.
+     * @tparam Stages Number of traced stages.
+     * @tparam Handler Handler of T.
+     */
+    template <typename T, size_t Stages, typename Handler>
+    class TracingEventHandler : public EventHandler<Traced<T, Stages>>
+    {
+    public:
+        /**
+         * @brief Constructs a TracingEventHandler.
+         *
+         * @param handler The handler receiving event values.
+         * @param stage Index of this stage in the trace block.
+         */
+        TracingEventHandler(Handler &handler, size_t stage)
+            : handler_(handler), stage_(stage)
+        {
+            if (stage >= Stages)
+            {
+                throw std::invalid_argument("Invalid stage in TracingEventHandler");
+            }
+        }
+
+        void onEvent(Traced<T, Stages> &event, int64_t sequence, bool endOfBatch) override
+        {
+            handler_.onEvent(event.value, sequence, endOfBatch);
+            event.trace.stageNs[stage_].ns = traceNow();
+        }
+
+        void onBatchStart(int64_t batchSize, int64_t queueDepth) override
+        {
+            handler_.onBatchStart(batchSize, queueDepth);
+        }
+
+        void onStart() override
+        {
+            handler_.onStart();
+        }
+
+        void onShutdown() override
+        {
+            handler_.onShutdown();
+        }
+
+        void onTimeout(int64_t sequence) override
+        {
+            handler_.onTimeout(sequence);
+        }
+
+        void setSequenceCallback(Sequence &sequenceCallback) override
+        {
+            handler_.setSequenceCallback(sequenceCallback);
+        }
+
+    private:
+        Handler &handler_;
+        size_t stage_;
+    };
+
+    /**
+     * @brief Latency distribution in power-of-two nanosecond buckets.
+     */
+    class LatencyHistogram
+    {
+    public:
+        static constexpr size_t kBuckets = 65; // bit widths 0 to 64
+
+        /**
+         * @brief Records one latency; negative values (clock skew) count as 0.
+         */
+        void record(int64_t ns) noexcept
+        {
+            const uint64_t value = ns > 0 ? static_cast<uint64_t>(ns) : 0;
+            ++counts_[static_cast<size_t>(std::bit_width(value))];
+            ++count_;
+            sum_ += value;
+            max_ = value > max_ ? value : max_;
+        }
+
+        /**
+         * @brief Gets an upper bound of a percentile.
+         *
+         * @param percentile In [0, 100].
+         * @return The upper bound of the bucket holding the percentile, in ns.
+         */
+        uint64_t percentile(double percentile) const noexcept
+        {
+            const uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(count_));
+            uint64_t seen = 0;
+            for (size_t bucket = 0; bucket < kBuckets; ++bucket)
+            {
+                seen += counts_[bucket];
+                if (seen > rank)
+                {
+                    return bucket == kBuckets - 1 ? max_ : (uint64_t{1} << bucket) - 1;
+                }
+            }
+            return max_;
+        }
+
+        uint64_t count() const noexcept { return count_; }
+        uint64_t max() const noexcept { return max_; }
+        double mean() const noexcept { return count_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(count_); }
+
+        /**
+         * @brief Gets the number of samples in [2^(bucket-1), 2^bucket) ns; bucket 0 holds 0 ns.
+         */
+        uint64_t bucketCount(size_t bucket) const { return counts_.at(bucket); }
+
+        void reset() noexcept { *this = LatencyHistogram{}; }
+
+    private:
+        std::array<uint64_t, kBuckets> counts_{};
+        uint64_t count_ = 0;
+        uint64_t sum_ = 0;
+        uint64_t max_ = 0;
+    };
+
+    /**
+     * @brief Final consumer turning trace blocks into per-hop latency histograms.
+     *
+     * Register it behind every traced stage. Hop k measures stage k's completion against the latest
+     * of its upstream stamps, given as a bitmask of stages (0 meaning the publication), so a diamond
+     * A -> {B, C} -> D uses {0, 1 << A, 1 << A, (1 << B) | (1 << C)}. The end-to-end histogram spans
+     * publication to the last stage. The histograms belong to the collector's thread; read them once
+     * its processor has halted.
+     *
+     * @tparam T The event type.
+     * @tparam Stages Number of traced stages.
+     */
+    template <typename T, size_t Stages>
+    class TraceCollector : public EventHandler<Traced<T, Stages>>
+    {
+        static_assert(Stages > 0 && Stages <= 32, "TraceCollector supports 1 to 32 stages");
+
+    public:
+        /**
+         * @brief Constructs a TraceCollector for a linear pipeline (stage k follows stage k - 1).
+         */
+        TraceCollector()
+        {
+            for (size_t stage = 1; stage < Stages; ++stage)
+            {
+                upstream_[stage] = uint32_t{1} << (stage - 1);
+            }
+        }
+
+        /**
+         * @brief Constructs a TraceCollector for an arbitrary stage graph.
+         *
+         * @param upstream For each stage, the bitmask of the stages it waits on; 0 for the producer.
+         */
+        explicit TraceCollector(const std::array<uint32_t, Stages> &upstream) : upstream_(upstream)
+        {
+            for (size_t stage = 0; stage < Stages; ++stage)
+            {
+                if (upstream[stage] >> stage != 0)
+                {
+                    throw std::invalid_argument("Stages may only wait on earlier stages in TraceCollector");
+                }
+            }
+        }
+
+        void onEvent(Traced<T, Stages> &event, int64_t sequence, bool endOfBatch) override
+        {
+            const TraceBlock<Stages> &trace = event.trace;
+            int64_t last = trace.publishNs;
+            for (size_t stage = 0; stage < Stages; ++stage)
+            {
+                int64_t start = trace.publishNs;
+                for (uint32_t mask = upstream_[stage]; mask != 0; mask &= mask - 1)
+                {
+                    const int64_t upstream = trace.stageNs[static_cast<size_t>(std::countr_zero(mask))].ns;
+                    start = upstream > start ? upstream : start;
+                }
+                const int64_t completed = trace.stageNs[stage].ns;
+                hops_[stage].record(completed - start);
+                last = completed > last ? completed : last;
+            }
+            endToEnd_.record(last - trace.publishNs);
+        }
+
+        /**
+         * @brief Gets the latency distribution of one stage, measured from its upstream stamps.
+         */
+        const LatencyHistogram &getHop(size_t stage) const
+        {
+            return hops_.at(stage);
+        }
+
+        /**
+         * @brief Gets the latency distribution from publication to the last stage's completion.
+         */
+        const LatencyHistogram &getEndToEnd() const
+        {
+            return endToEnd_;
+        }
+
+    private:
+        std::array<uint32_t, Stages> upstream_{};
+        std::array<LatencyHistogram, Stages> hops_{};
+        LatencyHistogram endToEnd_;
+    };
+
+} // namespace disruptor
@@ -0,0 +1,246 @@
+/**
+ * @file tsc_clock.h
+ * @brief Defines the TscClock, a calibrated cycle-counter clock for latency instrumentation.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+namespace disruptor
+{
+
+    /**
+     * @brief Nanosecond clock reading the CPU's counter directly, without a system call or vDSO.
+     *
+     * Reads rdtsc/rdtscp on x86 when the TSC is invariant (CPUID 0x80000007 EDX bit 8), and
+     * cntvct_el0 on aarch64. The tick rate is calibrated against steady_clock by calibrate(), which the
+     * application calls once at startup, before other threads read the clock; readings are offset to
+     * steady_clock's epoch, so values can be compared with it and with readings taken before
+     * calibration. Until then, elsewhere, or without an invariant TSC, every call falls back to
+     * steady_clock. The calibration is a plain static, so a reading costs no initialisation guard.
+     */
+    class TscClock
+    {
+    public:
+        /**
+         * @brief Calibrates the counter against steady_clock, busy-waiting for about 10ms.
+         *
+         * Not thread-safe: call it before any other thread reads the clock.
+         */
+        static void calibrate() noexcept
+        {
+            calibration_ = measure();
+        }
+
+        /**
+         * @brief Reads the raw counter, or steady_clock nanoseconds in fallback mode.
+         *
+         * Not ordered with surrounding loads and stores; see ticksOrdered().
+         */
+        static uint64_t ticks() noexcept
+        {
+            if (!calibration_.counter)
+            {
+                return static_cast<uint64_t>(steadyNs());
+            }
+#if defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#elif defined(__aarch64__)
+            uint64_t value;
+            asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+            return value;
+#else
+            return static_cast<uint64_t>(steadyNs());
+#endif
+        }
+
+        /**
+         * @brief Reads the counter after all earlier instructions have completed.
+         *
+         * Use to close a measured interval (rdtscp on x86, isb-ordered read on aarch64).
+         */
+        static uint64_t ticksOrdered() noexcept
+        {
+            if (!calibration_.counter)
+            {
+                return static_cast<uint64_t>(steadyNs());
+            }
+#if defined(__x86_64__) || defined(__i386__)
+            unsigned int aux;
+            return __rdtscp(&aux);
+#elif defined(__aarch64__)
+            uint64_t value;
+            asm volatile("isb\n\tmrs %0, cntvct_el0" : "=r"(value)::"memory");
+            return value;
+#else
+            return static_cast<uint64_t>(steadyNs());
+#endif
+        }
+
+        /**
+         * @brief Converts a ticks() reading to nanoseconds on steady_clock's epoch.
+         */
+        static int64_t toNs(uint64_t ticks) noexcept
+        {
+            const Calibration &c = calibration_;
+            if (!c.counter)
+            {
+                return static_cast<int64_t>(ticks);
+            }
+            return c.baseNs + scaleQ32(static_cast<int64_t>(ticks - c.baseTicks), c.nsPerTickQ32);
+        }
+
+        /**
+         * @brief Reads the clock in nanoseconds on steady_clock's epoch.
+         */
+        static int64_t nowNs() noexcept
+        {
+            return toNs(ticks());
+        }
+
+        /**
+         * @brief Checks whether the clock reads the CPU counter rather than falling back to steady_clock.
+         */
+        static bool usesCounter() noexcept
+        {
+            return calibration_.counter;
+        }
+
+        /**
+         * @brief Gets the calibrated counter frequency in Hz, or 1e9 in fallback mode.
+         */
+        static double frequencyHz() noexcept
+        {
+            const Calibration &c = calibration_;
+            return c.counter ? 4294967296.0 * 1e9 / static_cast<double>(c.nsPerTickQ32) : 1e9;
+        }
+
+    private:
+        struct Calibration
+        {
+            bool counter = false;
+            uint64_t baseTicks = 0;
+            int64_t baseNs = 0;
+            int64_t nsPerTickQ32 = 0; // nanoseconds per tick in 32.32 fixed point
+        };
+
+        static inline Calibration calibration_{false, 0, 0, 0}; // fallback until calibrate()
+
+        /**
+         * @brief Multiplies by a 32.32 fixed-point factor, without a 128-bit type where there is none.
+         */
+        static int64_t scaleQ32(int64_t value, int64_t factorQ32) noexcept
+        {
+#if defined(__SIZEOF_INT128__)
+            return static_cast<int64_t>((static_cast<__int128>(value) * factorQ32) >> 32);
+#else
+            // 32-bit halves, so no partial product overflows for a positive factor
+            const bool negative = value < 0;
+            const uint64_t magnitude = negative ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+            const uint64_t factor = static_cast<uint64_t>(factorQ32);
+            const uint64_t valueHigh = magnitude >> 32, valueLow = magnitude & 0xffffffffu;
+            const uint64_t factorHigh = factor >> 32, factorLow = factor & 0xffffffffu;
+            const uint64_t scaled = ((valueHigh * factorHigh) << 32) + valueHigh * factorLow +
+                                    valueLow * factorHigh + ((valueLow * factorLow) >> 32);
+            return negative ? -static_cast<int64_t>(scaled) : static_cast<int64_t>(scaled);
+#endif
+        }
+
+        static int64_t steadyNs() noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        }
+
+        static bool counterUsable() noexcept
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            unsigned int eax, ebx, ecx, edx;
+            if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007)
+            {
+                return false;
+            }
+            __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+            return (edx & (1u << 8)) != 0;
+#elif defined(__aarch64__)
+            return true; // the generic timer runs at a constant rate
+#else
+            return false;
+#endif
+        }
+
+        static uint64_t readCounter() noexcept
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            unsigned int aux;
+            return __rdtscp(&aux);
+#elif defined(__aarch64__)
+            uint64_t value;
+            asm volatile("isb\n\tmrs %0, cntvct_el0" : "=r"(value)::"memory");
+            return value;
+#else
+            return 0;
+#endif
+        }
+
+        /**
+         * @brief Samples the counter and steady_clock together, keeping the tightest pair.
+         */
+        static void sample(uint64_t &ticks, int64_t &ns) noexcept
+        {
+            int64_t best = INT64_MAX;
+            for (int i = 0; i < 5; ++i)
+            {
+                const uint64_t before = readCounter();
+                const int64_t now = steadyNs();
+                const uint64_t after = readCounter();
+                if (static_cast<int64_t>(after - before) < best)
+                {
+                    best = static_cast<int64_t>(after - before);
+                    ticks = before + (after - before) / 2;
+                    ns = now;
+                }
+            }
+        }
+
+        static Calibration measure() noexcept
+        {
+            Calibration c;
+            if (!counterUsable())
+            {
+                return c;
+            }
+
+            uint64_t startTicks = 0, endTicks = 0;
+            int64_t startNs = 0, endNs = 0;
+            sample(startTicks, startNs);
+            // a 10ms window keeps the rate error around 1e-6 given sub-10ns sampling error
+            while (steadyNs() - startNs < 10'000'000)
+            {
+            }
+            sample(endTicks, endNs);
+            // a window stretched past a second by preemption is discarded, which also keeps the
+            // shifted nanoseconds below from overflowing
+            if (endTicks <= startTicks || endNs - startNs > 1'000'000'000)
+            {
+                return c;
+            }
+
+            c.counter = true;
+            c.baseTicks = endTicks;
+            c.baseNs = endNs;
+            c.nsPerTickQ32 = static_cast<int64_t>((static_cast<uint64_t>(endNs - startNs) << 32) /
+                                                  (endTicks - startTicks));
+            return c;
+        }
+    };
+
+} // namespace disruptor
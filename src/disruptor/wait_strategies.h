@@ -74,6 +74,8 @@ namespace disruptor
     class BusySpinWaitStrategy
     {
     public:
+        static constexpr const char *kName = "BusySpinWaitStrategy"; // reported by Topology
+
         /**
          * @brief Waits for a sequence.
          *
@@ -10,14 +10,15 @@
 #include "disruptor/sequencer.h"
 #include "disruptor/wait_strategies.h"
 #include "disruptor/exception_handler.h"
+#include "disruptor/tsc_clock.h"
 
 using namespace disruptor;
 
+int64_t start_ns = 0; // set in main(), once the clock is calibrated
+
 inline int64_t now_ns()
 {
-    using namespace std::chrono;
-    static auto start = steady_clock::now();
-    return duration_cast<nanoseconds>(steady_clock::now() - start).count();
+    return TscClock::nowNs() - start_ns;
 }
 
 inline void log(const std::string &tag, int64_t seq, int64_t val)
@@ -210,6 +211,8 @@ void diamond()
 // ================================================
 int main()
 {
+    TscClock::calibrate();
+    start_ns = TscClock::nowNs();
     simple();
     diamond();
     return 0;
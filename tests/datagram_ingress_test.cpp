@@ -0,0 +1,194 @@
+// DatagramIngress over loopback UDP: every datagram must reach the ring once, in order, with its
+// length, source address and truncation flag, across many ring wraps and recvmmsg() batches.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "disruptor/datagram_ingress.h"
+#include "disruptor/event_handler.h"
+#include "disruptor/event_processor.h"
+#include "disruptor/exception_handler.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/sequencer.h"
+#include "disruptor/wait_strategies.h"
+
+using namespace disruptor;
+
+namespace
+{
+    constexpr size_t kBufferSize = 64;
+    constexpr size_t kCapacity = 64;
+    constexpr size_t kMaxBatch = 16;
+    constexpr int64_t kDatagrams = 10000;
+    constexpr int64_t kInFlight = 48; // well inside the socket buffer, so the kernel never drops
+    constexpr int64_t kOversizedEvery = 97;
+    constexpr auto kTimeout = std::chrono::seconds(60);
+
+    using TestDatagram = Datagram<kCapacity>;
+
+    auto testDatagramFactory = []() -> TestDatagram
+    {
+        return TestDatagram{};
+    };
+
+    size_t lengthOf(int64_t index)
+    {
+        return index % kOversizedEvery == 0 ? kCapacity + 16 : sizeof(int64_t) + static_cast<size_t>(index % 40);
+    }
+
+    /**
+     * @brief Checks each datagram against what the sender wrote for that index.
+     */
+    class CheckingHandler : public EventHandler<TestDatagram>
+    {
+    public:
+        explicit CheckingHandler(uint16_t senderPort) : senderPort_(senderPort) {}
+
+        void onEvent(TestDatagram &event, int64_t sequence, bool) override
+        {
+            const int64_t expected = received_.load(std::memory_order_relaxed);
+            int64_t index;
+            std::memcpy(&index, event.data.data(), sizeof(index));
+            const size_t length = lengthOf(expected);
+            const auto *source = reinterpret_cast<const sockaddr_in *>(&event.source);
+            // a truncated datagram reports the bytes stored, not its original length
+            if (sequence != expected || index != expected || event.length != std::min(length, kCapacity) ||
+                event.truncated != (length > kCapacity) || event.sourceLength != sizeof(sockaddr_in) ||
+                source->sin_port != senderPort_)
+            {
+                std::fprintf(stderr, "FAIL: sequence %lld, expected index %lld, got index %lld length %u\n",
+                             static_cast<long long>(sequence), static_cast<long long>(expected),
+                             static_cast<long long>(index), event.length);
+                std::_Exit(1);
+            }
+            received_.store(expected + 1, std::memory_order_release);
+        }
+
+        int64_t getReceived() const
+        {
+            return received_.load(std::memory_order_acquire);
+        }
+
+    private:
+        uint16_t senderPort_;
+        std::atomic<int64_t> received_{0};
+    };
+
+    int boundSocket(sockaddr_in &address)
+    {
+        const int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+        if (fd < 0)
+        {
+            std::perror("socket");
+            std::exit(1);
+        }
+        address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        if (::bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+            ::getsockname(fd, reinterpret_cast<sockaddr *>(&address), &length) != 0)
+        {
+            std::perror("bind");
+            std::exit(1);
+        }
+        return fd;
+    }
+}
+
+int main()
+{
+    sockaddr_in receiverAddress;
+    sockaddr_in senderAddress;
+    const int receiver = boundSocket(receiverAddress);
+    const int sender = boundSocket(senderAddress);
+    if (::connect(sender, reinterpret_cast<sockaddr *>(&receiverAddress), sizeof(receiverAddress)) != 0)
+    {
+        std::perror("connect");
+        return 1;
+    }
+
+    BusySpinWaitStrategy waitStrategy;
+    SingleProducerSequencer<kBufferSize, BusySpinWaitStrategy> sequencer(waitStrategy);
+    RingBuffer<TestDatagram, kBufferSize, decltype(sequencer), decltype(testDatagramFactory)>
+        ringBuffer(sequencer, testDatagramFactory);
+    auto barrier = sequencer.newBarrier({});
+
+    DefaultExceptionHandler<TestDatagram> exceptionHandler;
+    CheckingHandler handler(senderAddress.sin_port);
+    EventProcessor<TestDatagram, decltype(ringBuffer), decltype(barrier), CheckingHandler>
+        processor(ringBuffer, barrier, handler, exceptionHandler);
+    ringBuffer.setGatingSequences({&processor.getSequence()});
+
+    DatagramIngress<decltype(ringBuffer), kCapacity, kMaxBatch> ingress(ringBuffer, receiver);
+
+    std::thread consumer([&]
+                         { processor.run(); });
+    std::thread producer([&]
+                         { ingress.run(); });
+
+    const auto deadline = std::chrono::steady_clock::now() + kTimeout;
+    char payload[kCapacity + 16] = {};
+    for (int64_t i = 0; i < kDatagrams; ++i)
+    {
+        while (i - handler.getReceived() >= kInFlight)
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                std::fprintf(stderr, "FAIL: stuck at %lld of %lld, dropped %llu\n",
+                             static_cast<long long>(handler.getReceived()), static_cast<long long>(kDatagrams),
+                             static_cast<unsigned long long>(ingress.getDroppedCount()));
+                std::_Exit(1);
+            }
+            std::this_thread::yield();
+        }
+        std::memcpy(payload, &i, sizeof(i));
+        if (::send(sender, payload, lengthOf(i), 0) < 0)
+        {
+            std::perror("send");
+            return 1;
+        }
+    }
+
+    while (handler.getReceived() < kDatagrams)
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            std::fprintf(stderr, "FAIL: received %lld of %lld\n",
+                         static_cast<long long>(handler.getReceived()), static_cast<long long>(kDatagrams));
+            std::_Exit(1);
+        }
+        std::this_thread::yield();
+    }
+
+    ingress.halt();
+    producer.join();
+    processor.halt();
+    consumer.join();
+    ::close(sender);
+    ::close(receiver);
+
+    const uint64_t oversized = static_cast<uint64_t>((kDatagrams - 1) / kOversizedEvery + 1);
+    if (ingress.getTruncatedCount() != oversized || ingress.getDroppedCount() != 0)
+    {
+        std::fprintf(stderr, "FAIL: truncated %llu (expected %llu), dropped %llu\n",
+                     static_cast<unsigned long long>(ingress.getTruncatedCount()),
+                     static_cast<unsigned long long>(oversized),
+                     static_cast<unsigned long long>(ingress.getDroppedCount()));
+        return 1;
+    }
+    std::printf("PASS: %lld datagrams, %lld wraps, %llu truncated\n", static_cast<long long>(kDatagrams),
+                static_cast<long long>(kDatagrams / static_cast<int64_t>(kBufferSize)),
+                static_cast<unsigned long long>(ingress.getTruncatedCount()));
+    return 0;
+}
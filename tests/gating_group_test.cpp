@@ -0,0 +1,172 @@
+// Stress test for GatingGroup: several consumers gated through one group, over many ring wraps.
+// A lost group-minimum update leaves the producer blocked; the watchdog turns that into a failure.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "disruptor/event_handler.h"
+#include "disruptor/event_processor.h"
+#include "disruptor/exception_handler.h"
+#include "disruptor/gating_group.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/sequencer.h"
+#include "disruptor/wait_strategies.h"
+
+using namespace disruptor;
+
+namespace
+{
+    constexpr size_t kBufferSize = 64;
+    constexpr size_t kConsumers = 4;
+    constexpr auto kStallTimeout = std::chrono::seconds(20);
+
+    struct TestEvent
+    {
+        int64_t value;
+    };
+
+    auto testEventFactory = []() -> TestEvent
+    {
+        return TestEvent{0};
+    };
+
+    class CheckingHandler : public EventHandler<TestEvent>
+    {
+    public:
+        void onEvent(TestEvent &event, int64_t sequence, bool) override
+        {
+            if (event.value != sequence || sequence != expected_)
+            {
+                std::fprintf(stderr, "FAIL: expected %lld, got sequence %lld value %lld\n",
+                             static_cast<long long>(expected_), static_cast<long long>(sequence),
+                             static_cast<long long>(event.value));
+                std::_Exit(1);
+            }
+            ++expected_;
+        }
+
+    private:
+        int64_t expected_ = 0;
+    };
+}
+
+int main()
+{
+    // every thread busy-spins, so only run the long version when each one has a core
+    const int64_t events = std::thread::hardware_concurrency() > kConsumers ? int64_t{1} << 22 : int64_t{1} << 15;
+
+    BusySpinWaitStrategy waitStrategy;
+    SingleProducerSequencer<kBufferSize, BusySpinWaitStrategy> sequencer(waitStrategy);
+    RingBuffer<TestEvent, kBufferSize, decltype(sequencer), decltype(testEventFactory)>
+        ringBuffer(sequencer, testEventFactory);
+
+    using Barrier = decltype(sequencer.newBarrier({}));
+    using Processor = EventProcessor<TestEvent, decltype(ringBuffer), Barrier, CheckingHandler>;
+
+    DefaultExceptionHandler<TestEvent> exceptionHandler;
+    std::vector<std::unique_ptr<Barrier>> barriers;
+    std::vector<CheckingHandler> handlers(kConsumers);
+    std::vector<std::unique_ptr<Processor>> processors;
+    std::vector<Sequence *> members;
+    for (size_t i = 0; i < kConsumers; ++i)
+    {
+        barriers.emplace_back(new Barrier(sequencer.newBarrier({})));
+        // a small batch makes members report, and race on the minimum, more often
+        processors.push_back(std::make_unique<Processor>(ringBuffer, *barriers[i], handlers[i], exceptionHandler, 4));
+        members.push_back(&processors[i]->getSequence());
+    }
+
+    GatingGroup group(members);
+    for (auto &processor : processors)
+    {
+        processor->setGatingGroup(group);
+    }
+    ringBuffer.setGatingSequences({&group.getSequence()});
+
+    std::vector<std::thread> consumers;
+    for (auto &processor : processors)
+    {
+        consumers.emplace_back([&processor]
+                               { processor->run(); });
+    }
+
+    std::atomic<bool> done{false};
+    std::thread watchdog([&]
+                         {
+        int64_t last = -2;
+        auto lastMove = std::chrono::steady_clock::now();
+        while (!done.load(std::memory_order_acquire))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            const int64_t minimum = group.getSequence().get();
+            const auto now = std::chrono::steady_clock::now();
+            if (minimum != last)
+            {
+                last = minimum;
+                lastMove = now;
+            }
+            else if (now - lastMove > kStallTimeout)
+            {
+                std::fprintf(stderr, "FAIL: group minimum stuck at %lld, cursor %lld\n",
+                             static_cast<long long>(minimum), static_cast<long long>(ringBuffer.getCursor()));
+                std::_Exit(1);
+            }
+        } });
+
+    for (int64_t i = 0; i < events; ++i)
+    {
+        const int64_t sequence = ringBuffer.next();
+        ringBuffer.get(sequence).value = sequence;
+        ringBuffer.publish(sequence);
+    }
+
+    while (group.getSequence().get() < events - 1)
+    {
+        std::this_thread::yield();
+    }
+    done.store(true, std::memory_order_release);
+    watchdog.join();
+
+    for (auto &processor : processors)
+    {
+        processor->halt();
+    }
+    for (auto &consumer : consumers)
+    {
+        consumer.join();
+    }
+
+    for (size_t i = 0; i < kConsumers; ++i)
+    {
+        if (processors[i]->getSequence().get() != events - 1)
+        {
+            std::fprintf(stderr, "FAIL: consumer %zu stopped at %lld\n", i,
+                         static_cast<long long>(processors[i]->getSequence().get()));
+            return 1;
+        }
+    }
+    // an empty group would freeze its minimum, so the last member cannot leave
+    for (size_t i = 1; i < kConsumers; ++i)
+    {
+        group.removeMember(processors[i]->getSequence());
+    }
+    try
+    {
+        group.removeMember(processors[0]->getSequence());
+        std::fprintf(stderr, "FAIL: removed the last member of the group\n");
+        return 1;
+    }
+    catch (const std::logic_error &)
+    {
+    }
+
+    std::printf("PASS: %zu consumers, %lld events, %lld wraps\n", kConsumers,
+                static_cast<long long>(events), static_cast<long long>(events / kBufferSize));
+    return 0;
+}
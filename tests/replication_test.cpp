@@ -0,0 +1,248 @@
+// Replication over a lossy link: a proxy between the primary and the standby drops and reorders
+// datagrams, and the standby ring must still receive exactly the primary's sequences, in order.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "disruptor/event_handler.h"
+#include "disruptor/event_processor.h"
+#include "disruptor/exception_handler.h"
+#include "disruptor/replication.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/sequencer.h"
+#include "disruptor/wait_strategies.h"
+
+using namespace disruptor;
+
+namespace
+{
+    constexpr size_t kBufferSize = 1024;
+    constexpr size_t kStandbySize = 32; // smaller than a datagram's worth of events, so claims are split
+    constexpr size_t kHistorySize = 32768; // covers every event, so no gap outlives the history
+    constexpr int64_t kEvents = 20000;
+    constexpr auto kTimeout = std::chrono::seconds(60);
+
+    struct TestEvent
+    {
+        int64_t value;
+        int64_t payload[3];
+    };
+
+    auto testEventFactory = []() -> TestEvent
+    {
+        return TestEvent{};
+    };
+
+    /**
+     * @brief Checks the standby sees every primary sequence once, in order, at the same ring sequence.
+     */
+    class CheckingHandler : public EventHandler<TestEvent>
+    {
+    public:
+        void onEvent(TestEvent &event, int64_t sequence, bool) override
+        {
+            const int64_t expected = received_.load(std::memory_order_relaxed);
+            if (event.value != expected || sequence != expected || event.payload[2] != ~expected)
+            {
+                std::fprintf(stderr, "FAIL: expected %lld, got sequence %lld value %lld\n",
+                             static_cast<long long>(expected), static_cast<long long>(sequence),
+                             static_cast<long long>(event.value));
+                std::_Exit(1);
+            }
+            received_.store(expected + 1, std::memory_order_release);
+        }
+
+        int64_t getReceived() const
+        {
+            return received_.load(std::memory_order_acquire);
+        }
+
+    private:
+        std::atomic<int64_t> received_{0};
+    };
+
+    /**
+     * @brief Forwards datagrams both ways, dropping and reordering data from the primary.
+     */
+    class LossyProxy
+    {
+    public:
+        LossyProxy(int primary, int standby) : primary_(primary), standby_(standby) {}
+
+        void run(const std::atomic<bool> &stop)
+        {
+            std::mt19937 random(42);
+            std::vector<char> held;
+            char buffer[2048];
+            while (!stop.load(std::memory_order_acquire))
+            {
+                bool idle = true;
+                ssize_t size;
+                while ((size = ::recv(primary_, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0)
+                {
+                    idle = false;
+                    const auto *header = reinterpret_cast<const ReplicationHeader *>(buffer);
+                    if (header->type != ReplicationMessage::DATA)
+                    {
+                        ::send(standby_, buffer, static_cast<size_t>(size), 0);
+                        continue;
+                    }
+                    const unsigned roll = random() % 10;
+                    if (roll == 0)
+                    {
+                        ++dropped_;
+                    }
+                    else if (roll == 1 && held.empty())
+                    {
+                        // delivered after the next datagram
+                        held.assign(buffer, buffer + size);
+                        ++reordered_;
+                    }
+                    else
+                    {
+                        ::send(standby_, buffer, static_cast<size_t>(size), 0);
+                        releaseHeld(held);
+                    }
+                }
+                while ((size = ::recv(standby_, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0)
+                {
+                    idle = false;
+                    ::send(primary_, buffer, static_cast<size_t>(size), 0);
+                }
+                if (idle)
+                {
+                    releaseHeld(held);
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        int getDropped() const { return dropped_; }
+        int getReordered() const { return reordered_; }
+
+    private:
+        int primary_;
+        int standby_;
+        int dropped_ = 0;
+        int reordered_ = 0;
+
+        void releaseHeld(std::vector<char> &held)
+        {
+            if (!held.empty())
+            {
+                ::send(standby_, held.data(), held.size(), 0);
+                held.clear();
+            }
+        }
+    };
+}
+
+int main()
+{
+    // primary <-> proxy <-> standby
+    int primaryLink[2];
+    int standbyLink[2];
+    if (::socketpair(AF_UNIX, SOCK_DGRAM, 0, primaryLink) != 0 || ::socketpair(AF_UNIX, SOCK_DGRAM, 0, standbyLink) != 0)
+    {
+        std::perror("socketpair");
+        return 1;
+    }
+
+    using Sequencer = SingleProducerSequencer<kBufferSize, BusySpinWaitStrategy>;
+    BusySpinWaitStrategy waitStrategy;
+    DefaultExceptionHandler<TestEvent> exceptionHandler;
+
+    Sequencer primarySequencer(waitStrategy);
+    RingBuffer<TestEvent, kBufferSize, Sequencer, decltype(testEventFactory)> primary(primarySequencer, testEventFactory);
+    auto primaryBarrier = primarySequencer.newBarrier({});
+    ReplicatorHandler<TestEvent, kHistorySize> replicator(primaryLink[0]);
+    EventProcessor<TestEvent, decltype(primary), decltype(primaryBarrier), decltype(replicator)>
+        replicatorProcessor(primary, primaryBarrier, replicator, exceptionHandler);
+    primary.setGatingSequences({&replicatorProcessor.getSequence()});
+
+    using StandbySequencer = SingleProducerSequencer<kStandbySize, BusySpinWaitStrategy>;
+    StandbySequencer standbySequencer(waitStrategy);
+    RingBuffer<TestEvent, kStandbySize, StandbySequencer, decltype(testEventFactory)> standby(standbySequencer, testEventFactory);
+    auto standbyBarrier = standbySequencer.newBarrier({});
+    CheckingHandler checker;
+    EventProcessor<TestEvent, decltype(standby), decltype(standbyBarrier), CheckingHandler>
+        checkerProcessor(standby, standbyBarrier, checker, exceptionHandler);
+    standby.setGatingSequences({&checkerProcessor.getSequence()});
+    ReplicaReceiver<decltype(standby), TestEvent> receiver(standby, standbyLink[1], 0, 1'000'000, 256);
+
+    LossyProxy proxy(primaryLink[1], standbyLink[0]);
+    std::atomic<bool> stop{false};
+    std::thread proxyThread([&]
+                            { proxy.run(stop); });
+    std::thread ticker([&]
+                       {
+        while (!stop.load(std::memory_order_acquire))
+        {
+            replicator.tick();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        } });
+    std::thread replicatorThread([&]
+                                 { replicatorProcessor.run(); });
+    std::thread checkerThread([&]
+                              { checkerProcessor.run(); });
+    std::thread receiverThread([&]
+                               { receiver.run(); });
+
+    for (int64_t i = 0; i < kEvents; ++i)
+    {
+        const int64_t sequence = primary.next();
+        TestEvent &event = primary.get(sequence);
+        event.value = i;
+        event.payload[0] = i * 3;
+        event.payload[1] = -i;
+        event.payload[2] = ~i;
+        primary.publish(sequence);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    while (checker.getReceived() < kEvents && std::chrono::steady_clock::now() - start < kTimeout)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    stop.store(true, std::memory_order_release);
+    receiver.halt();
+    replicatorProcessor.halt();
+    checkerProcessor.halt();
+    receiverThread.join();
+    checkerThread.join();
+    replicatorThread.join();
+    ticker.join();
+    proxyThread.join();
+    for (const int fd : {primaryLink[0], primaryLink[1], standbyLink[0], standbyLink[1]})
+    {
+        ::close(fd);
+    }
+
+    const int64_t received = checker.getReceived();
+    std::printf("received %lld/%lld, dropped %d, reordered %d, naks %llu, retransmitted %llu\n",
+                static_cast<long long>(received), static_cast<long long>(kEvents), proxy.getDropped(),
+                proxy.getReordered(), static_cast<unsigned long long>(receiver.getNakCount()),
+                static_cast<unsigned long long>(replicator.getRetransmitCount()));
+    if (received != kEvents || receiver.getExpectedSequence() != kEvents || standby.getCursor() != kEvents - 1)
+    {
+        std::fprintf(stderr, "FAIL: standby incomplete\n");
+        return 1;
+    }
+    if (proxy.getDropped() == 0 || proxy.getReordered() == 0 || receiver.getNakCount() == 0)
+    {
+        std::fprintf(stderr, "FAIL: the link was not impaired, gap recovery not exercised\n");
+        return 1;
+    }
+    std::printf("PASS\n");
+    return 0;
+}